@@ -1,19 +1,89 @@
 #include "binomial-coeff.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "../../doctest/doctest.h"
 
 #include "../pe-maths/factorial.cpp"
+#include "../pe-maths/primes.cpp"
+#include "../pe-custom/uint.h"
 
 /*
  * @return number of ways to choose k items from n items without repetition and
  * without order, namely C(n, k).
+ *
+ * No factorial is ever computed in full. Values that fit in 64 bits come from
+ * nativeBinomialCoefficient(), while larger values with few factors use the same
+ * multiplicative formula on a BigInt, which only grows to the size of the result.
+ *
+ * From kummerLimit factors onwards, the result is instead built from its prime
+ * factorisation. By Legendre's formula, the exponent of every prime p <= n in C(n, k) is
+ * the sum of floor(n/p^i) - floor(k/p^i) - floor((n-k)/p^i), which, by Kummer's theorem,
+ * is the amount of carries when adding k & n - k in base p. So it is at most log_p(n)
+ * & is only ever 0 or 1 for p > sqrt(n).
  */
 BigInt binomialCoefficient(unsigned long n, unsigned long k)
 {
     if (k > n)
         return BigInt::zero();
+    if (const auto native = nativeBinomialCoefficient(n, k))
+        return BigInt {*native};
+
+    k = std::min(k, n - k);
+    // based on timings of both methods, which are about even at k = 128
+    const unsigned long kummerLimit {128};
+    if (k < kummerLimit) {
+        BigInt result {BigInt::one()};
+        for (unsigned long i {1}; i <= k; ++i) {
+            result *= static_cast<unsigned long long>(n - k + i);
+            result /= static_cast<unsigned long long>(i);
+        }
+        return result;
+    }
+
+    std::vector<unsigned long> primes, exponents;
+    for (const auto p : primeNumbers(n)) {
+        unsigned long exponent {};
+        for (auto q = n, r = k, s = n - k; q >= p; ) {
+            q /= p;
+            r /= p;
+            s /= p;
+            exponent += q - r - s;
+        }
+        if (exponent) {
+            primes.push_back(p);
+            exponents.push_back(exponent);
+        }
+    }
+
+    return primePowerProduct(primes, exponents);
+}
+
+/*
+ * Uses the multiplicative formula C(n, k) = Pi((n - k + i) / i) for i in [1, k], with
+ * k replaced by the smaller of k & n - k. Every partial product C(n - k + i, i) is an
+ * integer no greater than the final result, so each step multiplies into 128 bits & only
+ * fails when the quotient of the exact division by i no longer fits in 64 bits.
+ *
+ * @return C(n, k) if it fits in 64 bits, or an empty optional otherwise.
+ */
+std::optional<std::uint64_t> nativeBinomialCoefficient(unsigned long n, unsigned long k)
+{
+    if (k > n)
+        return 0;
 
-    return factorial(n) / (factorial(k) * factorial(n - k));
+    k = std::min(k, n - k);
+    std::uint64_t result {1};
+    for (unsigned long i {1}; i <= k; ++i) {
+        std::uint64_t high {}, remainder;
+        const auto low = uint_detail::mulAdd(result, n - k + i, 0, 0, high);
+        if (high >= i)
+            return std::nullopt;
+        result = uint_detail::divWide(high, low, i, remainder);
+    }
+
+    return result;
 }
 
 TEST_SUITE("test binomialCoefficient()") {
@@ -43,4 +113,33 @@ TEST_SUITE("test binomialCoefficient()") {
             CHECK_EQ(e, binomialCoefficient(nValues[i], kValues[i]));
         }
     }
-}
\ No newline at end of file
+
+    TEST_CASE("with native values") {
+        CHECK_EQ(137'846'528'820uLL, nativeBinomialCoefficient(40, 20));
+        CHECK_EQ(0, nativeBinomialCoefficient(3, 4));
+        CHECK_EQ(1, nativeBinomialCoefficient(1'000'000'000, 1'000'000'000));
+        CHECK_EQ(499'999'999'500'000'000uLL,
+                 nativeBinomialCoefficient(1'000'000'000, 999'999'998));
+        CHECK_EQ(14'226'520'737'620'288'370uLL, nativeBinomialCoefficient(67, 33));
+        CHECK_FALSE(nativeBinomialCoefficient(68, 34));
+        CHECK_EQ(BigInt {"28453041475240576740"}, binomialCoefficient(68, 34));
+    }
+
+    TEST_CASE("with upper constraints") {
+        for (unsigned long n : {70uL, 200uL, 300uL, 1000uL}) {
+            for (unsigned long k {0}; k <= n; k += n / 20 + 1) {
+                CAPTURE(n);
+                CAPTURE(k);
+                CHECK_EQ(factorial(n) / (factorial(k) * factorial(n - k)),
+                         binomialCoefficient(n, k));
+            }
+        }
+        // Pascal's rule, across the switch between methods
+        for (unsigned long k {1}; k < 300; ++k) {
+            CAPTURE(k);
+            CHECK_EQ(binomialCoefficient(599, k - 1) + binomialCoefficient(599, k),
+                     binomialCoefficient(600, k));
+        }
+        CHECK_EQ(300, binomialCoefficient(1000, 500).length());
+    }
+}
@@ -1,8 +1,13 @@
 #ifndef PROJECT_EULER_CPP_BINOMIAL_COEFF_H
 #define PROJECT_EULER_CPP_BINOMIAL_COEFF_H
 
+#include <cstdint>
+#include <optional>
+
 #include "../pe-maths/factorial.h"
 
 BigInt binomialCoefficient(unsigned long n, unsigned long k);
 
-#endif //PROJECT_EULER_CPP_BINOMIAL_COEFF_H
\ No newline at end of file
+std::optional<std::uint64_t> nativeBinomialCoefficient(unsigned long n, unsigned long k);
+
+#endif //PROJECT_EULER_CPP_BINOMIAL_COEFF_H
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <numeric>
 #include <string>
+#include <vector>
 
 /*
  * Mimics the Python itertools module function and returns r-length subLists of elements.
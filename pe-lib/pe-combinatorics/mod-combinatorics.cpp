@@ -0,0 +1,72 @@
+#include "mod-combinatorics.h"
+
+#include "binomial-coeff.h"
+
+#include "../../doctest/doctest.h"
+
+TEST_SUITE("test ModCombinatorics") {
+    constexpr std::uint32_t prime {1'000'000'007};
+
+    TEST_CASE("factorials and inverses") {
+        const ModCombinatorics<prime> mod {1000};
+        CHECK_EQ(1000, mod.limit());
+        CHECK_EQ(1, mod.factorial(0));
+        CHECK_EQ(3'628'800, mod.factorial(10));
+        CHECK_EQ(factorial(1000) % prime, mod.factorial(1000));
+        CHECK_EQ(0, mod.factorial(prime));
+        for (unsigned long long n {0}; n <= 1000; n += 37) {
+            CHECK_EQ(1, static_cast<std::uint64_t>(mod.factorial(n)) *
+                        mod.inverseFactorial(n) % prime);
+        }
+        for (unsigned long long n {1}; n <= 1000; n += 37) {
+            CHECK_EQ(1, n * mod.inverseOf(n) % prime);
+            CHECK_EQ(mod.inverseOf(n), ModCombinatorics<prime>::inverse(n));
+        }
+        CHECK_EQ(500'000'004, ModCombinatorics<prime>::inverse(2));
+        CHECK_EQ(1'024, ModCombinatorics<prime>::power(2, 10));
+
+        CHECK_THROWS_AS(mod.factorial(1001), std::out_of_range);
+        CHECK_THROWS_AS(mod.inverseFactorial(1001), std::out_of_range);
+        CHECK_THROWS_AS(mod.inverseOf(0), std::invalid_argument);
+        CHECK_THROWS_AS(ModCombinatorics<prime>::inverse(2uLL * prime),
+                        std::invalid_argument);
+    }
+
+    TEST_CASE("binomial coefficients below the modulus") {
+        const ModCombinatorics<prime> mod {1000};
+        for (unsigned long n {0}; n <= 1000; n += 47) {
+            for (unsigned long k {0}; k <= n; k += 13) {
+                CAPTURE(n);
+                CAPTURE(k);
+                CHECK_EQ(binomialCoefficient(n, k) % prime, mod.binomial(n, k));
+            }
+        }
+        CHECK_EQ(0, mod.binomial(3, 4));
+        CHECK_THROWS_AS(mod.binomial(1001, 1), std::out_of_range);
+    }
+
+    TEST_CASE("binomial coefficients by Lucas' theorem") {
+        // tables for a small modulus stop at MOD - 1, whatever the limit
+        const ModCombinatorics<13> mod {1'000'000};
+        CHECK_EQ(12, mod.limit());
+
+        // Pascal's triangle modulo 13, well past the modulus
+        std::vector<std::uint32_t> row {1};
+        for (unsigned long n {1}; n <= 400; ++n) {
+            std::vector<std::uint32_t> next(n + 1, 1);
+            for (unsigned long k {1}; k < n; ++k) {
+                next[k] = (row[k-1] + row[k]) % 13;
+            }
+            row = std::move(next);
+            for (unsigned long k {0}; k <= n; ++k) {
+                CAPTURE(n);
+                CAPTURE(k);
+                CHECK_EQ(row[k], mod.binomial(n, k));
+            }
+        }
+
+        CHECK_EQ(binomialCoefficient(10'000, 5'000) % 13uLL, mod.binomial(10'000, 5'000));
+        CHECK_EQ(0, mod.factorial(13));
+        CHECK_THROWS_AS(ModCombinatorics<13> {5}.binomial(20, 6), std::out_of_range);
+    }
+}
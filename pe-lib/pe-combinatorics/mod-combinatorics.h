@@ -0,0 +1,151 @@
+#ifndef PROJECT_EULER_CPP_MOD_COMBINATORICS_H
+#define PROJECT_EULER_CPP_MOD_COMBINATORICS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/*
+ * Factorials, inverse factorials & binomial coefficients modulo a prime MOD, for
+ * problems that only ask for a result modulo MOD, so that no exact value is computed.
+ *
+ * Tables of n! & (n!)^-1 for every n up to a limit are built on construction in O(N),
+ * with a single modular inversion, of the largest factorial, from which every smaller
+ * inverse factorial follows as (n!)^-1 = ((n + 1)!)^-1 * (n + 1). C(n, k) below the
+ * limit then costs 2 multiplications.
+ *
+ * Factorials of n >= MOD are all 0 modulo MOD, so tables never extend past MOD - 1.
+ * Binomial coefficients with n >= MOD are instead found by Lucas' theorem, as the
+ * product of the coefficients of the base MOD digits of n & k, which needs tables up to
+ * MOD - 1 whenever a digit exceeds the limit.
+ *
+ * MOD must fit in 32 bits, so that every product of 2 residues fits in 64 bits.
+ */
+template <std::uint32_t MOD>
+class ModCombinatorics {
+public:
+    static_assert(MOD > 1, "Modulus must be a prime");
+
+    /*
+     * @param limit largest n that the tables should cover.
+     */
+    explicit ModCombinatorics(unsigned long long limit)
+        : m_limit {std::min<unsigned long long>(limit, MOD - 1)},
+          m_factorials(m_limit + 1), m_inverseFactorials(m_limit + 1)
+    {
+        m_factorials[0] = 1;
+        for (std::size_t i {1}; i <= m_limit; ++i) {
+            m_factorials[i] = static_cast<std::uint64_t>(m_factorials[i-1]) * i % MOD;
+        }
+        m_inverseFactorials[m_limit] = inverse(m_factorials[m_limit]);
+        for (auto i = m_limit; i > 0; --i) {
+            m_inverseFactorials[i-1] =
+                    static_cast<std::uint64_t>(m_inverseFactorials[i]) * i % MOD;
+        }
+    }
+
+    static std::uint32_t power(std::uint64_t base, unsigned long long exponent)
+    {
+        std::uint64_t result {1};
+        base %= MOD;
+        while (exponent) {
+            if (exponent & 1)
+                result = result * base % MOD;
+            base = base * base % MOD;
+            exponent >>= 1;
+        }
+        return static_cast<std::uint32_t>(result % MOD);
+    }
+    /*
+     * Uses Fermat's little theorem, a^-1 = a^(MOD - 2) modulo a prime MOD.
+     *
+     * @throws std::invalid_argument if a is a multiple of MOD.
+     */
+    static std::uint32_t inverse(std::uint64_t a)
+    {
+        if (!(a % MOD))
+            throw std::invalid_argument("Multiples of the modulus have no inverse");
+
+        return power(a, MOD - 2);
+    }
+
+    unsigned long long limit() const { return m_limit; }
+
+    /*
+     * @throws std::out_of_range if n is above the limit, but below MOD.
+     */
+    std::uint32_t factorial(unsigned long long n) const
+    {
+        if (n >= MOD)
+            return 0;
+
+        return m_factorials[checked(n)];
+    }
+    /*
+     * @throws std::out_of_range if n is above the limit.
+     */
+    std::uint32_t inverseFactorial(unsigned long long n) const
+    {
+        return m_inverseFactorials[checked(n)];
+    }
+    /*
+     * @return n^-1 modulo MOD, as (n!)^-1 * (n - 1)!.
+     * @throws std::invalid_argument if n = 0.
+     * @throws std::out_of_range if n is above the limit.
+     */
+    std::uint32_t inverseOf(unsigned long long n) const
+    {
+        if (!n)
+            throw std::invalid_argument("0 has no inverse");
+
+        return static_cast<std::uint64_t>(m_inverseFactorials[checked(n)]) *
+                m_factorials[n-1] % MOD;
+    }
+
+    /*
+     * @return C(n, k) modulo MOD.
+     * @throws std::out_of_range if n, or a base MOD digit of n once n >= MOD, is above
+     * the limit.
+     */
+    std::uint32_t binomial(unsigned long long n, unsigned long long k) const
+    {
+        if (k > n)
+            return 0;
+        if (n < MOD)
+            return smallBinomial(n, k);
+
+        std::uint64_t result {1};
+        while (n && result) {
+            result = result * smallBinomial(n % MOD, k % MOD) % MOD;
+            n /= MOD;
+            k /= MOD;
+        }
+        return static_cast<std::uint32_t>(result);
+    }
+
+private:
+    unsigned long long m_limit;
+    std::vector<std::uint32_t> m_factorials;
+    std::vector<std::uint32_t> m_inverseFactorials;
+
+    std::size_t checked(unsigned long long n) const
+    {
+        if (n > m_limit)
+            throw std::out_of_range("Value exceeds the table limit");
+
+        return static_cast<std::size_t>(n);
+    }
+
+    // n < MOD
+    std::uint32_t smallBinomial(unsigned long long n, unsigned long long k) const
+    {
+        if (k > n)
+            return 0;
+
+        return static_cast<std::uint64_t>(m_factorials[checked(n)]) *
+                m_inverseFactorials[k] % MOD * m_inverseFactorials[n-k] % MOD;
+    }
+};
+
+#endif //PROJECT_EULER_CPP_MOD_COMBINATORICS_H
@@ -0,0 +1,150 @@
+#include "arena.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../../doctest/doctest.h"
+
+TEST_SUITE("test Arena") {
+    TEST_CASE("allocations are aligned and distinct") {
+        Arena arena {64};
+        auto* a = static_cast<char*>(arena.allocate(3, 1));
+        auto* b = arena.allocate(8, 8);
+        auto* c = arena.allocate(100, 16);
+
+        CHECK_NE(static_cast<void*>(a), b);
+        CHECK_EQ(0, reinterpret_cast<std::uintptr_t>(b) % 8);
+        CHECK_EQ(0, reinterpret_cast<std::uintptr_t>(c) % 16);
+        CHECK_GE(static_cast<char*>(b), a + 3);
+        CHECK_EQ(3, arena.allocations());
+        CHECK_GE(arena.capacity(), 64 + 100);
+    }
+
+    TEST_CASE("rewind() reuses blocks") {
+        Arena arena {64};
+        const auto start = arena.mark();
+        auto* first = arena.allocate(48, 8);
+        arena.allocate(48, 8);
+        const auto capacity = arena.capacity();
+
+        arena.rewind(start);
+        CHECK_EQ(first, arena.allocate(48, 8));
+        arena.allocate(48, 8);
+        CHECK_EQ(capacity, arena.capacity());
+    }
+
+    TEST_CASE("scopes nest and restore the current arena") {
+        Arena outer, inner;
+        CHECK_EQ(nullptr, Arena::current());
+        {
+            const ArenaScope outerScope {&outer};
+            const auto* kept = outer.allocate(16, 8);
+            {
+                const ArenaScope innerScope {&inner};
+                CHECK_EQ(&inner, Arena::current());
+                {
+                    const ArenaScope heap {nullptr};
+                    CHECK_EQ(nullptr, Arena::current());
+                }
+                const ArenaScope sameArena {&outer};
+                CHECK_NE(kept, outer.allocate(16, 8));
+            }
+            CHECK_EQ(&outer, Arena::current());
+            // the nested scope only released what was allocated within it
+            CHECK_NE(kept, outer.allocate(16, 8));
+        }
+        CHECK_EQ(nullptr, Arena::current());
+
+        const ArenaScope local;
+        CHECK_EQ(&Arena::local(), Arena::current());
+    }
+
+    TEST_CASE("containers bind to the arena current at their creation") {
+        Arena arena;
+        std::vector<int, ArenaAllocator<int>> onHeap {1, 2, 3};
+        {
+            const ArenaScope scope {&arena};
+            std::vector<int, ArenaAllocator<int>> inArena {4, 5, 6};
+            const auto copy = onHeap;
+
+            CHECK_EQ(&arena, inArena.get_allocator().arena());
+            CHECK_EQ(&arena, copy.get_allocator().arena());
+            CHECK_EQ(2, arena.allocations());
+            // storage is only moved between containers bound to the same arena
+            onHeap = std::move(inArena);
+        }
+
+        CHECK_EQ(nullptr, onHeap.get_allocator().arena());
+        CHECK_EQ(std::vector<int, ArenaAllocator<int>> {4, 5, 6}, onHeap);
+    }
+
+    TEST_CASE("scopes with live values are not rewound") {
+        Arena arena;
+        const auto start = arena.mark();
+        std::vector<std::vector<int, ArenaAllocator<int>>> outlived;
+        {
+            const ArenaScope scope {&arena};
+            std::vector<int, ArenaAllocator<int>> temporary {1, 2, 3};
+            std::vector<int, ArenaAllocator<int>> moved {4, 5, 6};
+            outlived.push_back(std::move(moved));
+        }
+        CHECK_LT(start, arena.mark());
+        const auto pinned = arena.mark();
+
+        // a later scope only rewinds to after the live values
+        {
+            const ArenaScope scope {&arena};
+            std::vector<int, ArenaAllocator<int>> temporary(100, 7);
+        }
+        CHECK_FALSE(pinned < arena.mark());
+        CHECK_FALSE(arena.mark() < pinned);
+        CHECK_EQ(std::vector<int, ArenaAllocator<int>> {4, 5, 6}, outlived.front());
+
+        // values counted against an enclosing scope are released with it
+        {
+            const ArenaScope outer {&arena};
+            {
+                const ArenaScope inner {&arena};
+                outlived.emplace_back(std::vector<int, ArenaAllocator<int>> {8, 9});
+            }
+            CHECK_LT(pinned, arena.mark());
+            outlived.pop_back();
+        }
+        CHECK_FALSE(pinned < arena.mark());
+    }
+
+    TEST_CASE("values that outlive every scope are released once destroyed") {
+        Arena arena {64};
+        const auto start = arena.mark();
+        auto scopedRange = [&arena](int size) {
+            const ArenaScope scope {&arena};
+            std::vector<int, ArenaAllocator<int>> temporary(size, 1);
+            std::vector<int, ArenaAllocator<int>> range(size, 2);
+            return range;
+        };
+
+        {
+            const auto kept = scopedRange(100);
+            CHECK_LT(start, arena.mark());
+        }
+        CHECK_FALSE(start < arena.mark());
+        const auto capacity = arena.capacity();
+        for (int i {0}; i < 1000; ++i) {
+            const auto range = scopedRange(100);
+            CHECK_EQ(2, range.back());
+        }
+        CHECK_FALSE(start < arena.mark());
+        CHECK_EQ(capacity, arena.capacity());
+
+        // a later scope only rewinds past them once they are all destroyed
+        auto outlived = std::make_unique<std::vector<int, ArenaAllocator<int>>>(
+                scopedRange(10));
+        {
+            const ArenaScope scope {&arena};
+            outlived.reset();
+            std::vector<int, ArenaAllocator<int>> temporary(10, 3);
+        }
+        CHECK_FALSE(start < arena.mark());
+    }
+}
@@ -0,0 +1,266 @@
+#ifndef PROJECT_EULER_CPP_ARENA_H
+#define PROJECT_EULER_CPP_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Bump allocator that hands out memory from a list of blocks and never frees individual
+ * allocations. Instead, the position in the blocks is rewound in bulk, after which the
+ * same blocks are reused, so a loop that rewinds once per iteration stops reaching the
+ * heap as soon as the blocks are large enough for a single iteration.
+ *
+ * Allocations made through an ArenaAllocator are also counted against the innermost
+ * ArenaScope of the arena until they are deallocated, so that a scope can tell whether
+ * any value created in it is still alive when it ends. Values that outlive every scope
+ * are counted against the arena itself, which rewinds past them once they have all been
+ * deallocated & no scope is active.
+ *
+ * An arena is not thread-safe & is meant to be used by a single thread, through an
+ * ArenaScope.
+ */
+class Arena {
+public:
+    // position in the blocks, to rewind to
+    struct Mark {
+        std::size_t block;
+        std::size_t offset;
+
+        friend bool operator<(Mark a, Mark b)
+        {
+            return a.block < b.block || (a.block == b.block && a.offset < b.offset);
+        }
+    };
+    // state of an ArenaScope, which keeps it so that entering a scope never allocates
+    struct Frame {
+        Mark mark;
+        // allocations made in the scope that have not been deallocated
+        std::size_t live;
+        Frame* enclosing;
+    };
+
+    explicit Arena(std::size_t blockSize = 1 << 16)
+        : m_blockSize {blockSize}, m_root {{}, 0, nullptr}, m_frame {&m_root} {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // arena used by allocators created on this thread, or nullptr for the heap
+    static Arena*& current()
+    {
+        thread_local Arena* arena {nullptr};
+        return arena;
+    }
+    // arena owned by this thread, for scopes that do not provide their own
+    static Arena& local()
+    {
+        thread_local Arena arena;
+        return arena;
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        ++m_allocations;
+        while (true) {
+            if (m_block == m_blocks.size()) {
+                const auto grown = m_blocks.empty() ? m_blockSize : 2 * m_blocks.back().size;
+                const auto size = std::max(bytes + alignment, grown);
+                m_blocks.push_back({std::make_unique<std::byte[]>(size), size});
+            }
+
+            auto& block = m_blocks[m_block];
+            const auto address = reinterpret_cast<std::uintptr_t>(block.data.get());
+            const auto start = (address + m_offset + alignment - 1) / alignment * alignment;
+            if (start + bytes <= address + block.size) {
+                m_offset = start + bytes - address;
+                return reinterpret_cast<void*>(start);
+            }
+            // a reused block that is too small is skipped until the next rewind
+            ++m_block;
+            m_offset = 0;
+        }
+    }
+
+    Mark mark() const { return {m_block, m_offset}; }
+    void rewind(Mark mark)
+    {
+        m_block = mark.block;
+        m_offset = mark.offset;
+    }
+
+    void enter(Frame& frame)
+    {
+        // values that outlived earlier scopes have all been deallocated
+        if (m_frame == &m_root && !m_root.live)
+            m_root.mark = mark();
+        frame = {mark(), 0, m_frame};
+        m_frame = &frame;
+    }
+    /*
+     * Rewinds to the start of the scope, unless values allocated in it are still alive,
+     * in which case their memory is kept & they are counted against the enclosing scope,
+     * or the arena itself for an outermost scope.
+     */
+    void leave(Frame& frame)
+    {
+        m_frame = frame.enclosing;
+        m_frame->live += frame.live;
+        if (!frame.live)
+            rewind(m_frame == &m_root && !m_root.live ? m_root.mark : frame.mark);
+    }
+    void retain() { ++m_frame->live; }
+    /*
+     * Counts the deallocation against the innermost scope that the memory belongs to, &
+     * rewinds past the values that outlived every scope once the last one is released.
+     */
+    void release(const void* ptr)
+    {
+        const auto position = positionOf(ptr);
+        for (auto* frame = m_frame; frame; frame = frame->enclosing) {
+            if (!(position < frame->mark)) {
+                if (frame->live)
+                    --frame->live;
+                if (m_frame == &m_root && !m_root.live)
+                    rewind(m_root.mark);
+                return;
+            }
+        }
+    }
+
+    // amount of allocations served since construction
+    std::size_t allocations() const { return m_allocations; }
+    // total bytes held in blocks, which are only released on destruction
+    std::size_t capacity() const
+    {
+        std::size_t total {};
+        for (const auto& block : m_blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    std::size_t m_block {};
+    std::size_t m_offset {};
+    std::size_t m_allocations {};
+    // counts values that outlive every scope, from the start of the first one
+    Frame m_root;
+    Frame* m_frame;
+
+    Mark positionOf(const void* ptr) const
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        for (std::size_t i {0}; i < m_blocks.size(); ++i) {
+            const auto start = reinterpret_cast<std::uintptr_t>(m_blocks[i].data.get());
+            if (address >= start && address < start + m_blocks[i].size)
+                return {i, address - start};
+        }
+        return {m_blocks.size(), 0};
+    }
+};
+
+/*
+ * Makes an arena current for this thread for the lifetime of the scope, then rewinds it
+ * to where it was on entry, releasing everything allocated from it in the scope at once.
+ * Scopes can be nested, including with the same arena, and a null arena makes the heap
+ * current again, e.g. for values that will be handed to other threads.
+ *
+ * Containers that use an ArenaAllocator bind to the arena current at their creation.
+ * Results are best kept by assigning them to values created outside the scope, which
+ * copies them into their own storage. A value that outlives the scope instead, e.g. by
+ * being returned from it or moved into an outer container, stops the scope from
+ * rewinding, so its memory stays valid, but is only reused once an enclosing scope of
+ * the same arena ends, or, without one, once every such value has been destroyed.
+ */
+class ArenaScope {
+public:
+    ArenaScope() : ArenaScope {&Arena::local()} {}
+    explicit ArenaScope(Arena* arena) : m_arena {arena}, m_previous {Arena::current()}
+    {
+        if (arena)
+            arena->enter(m_frame);
+        Arena::current() = arena;
+    }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ~ArenaScope()
+    {
+        Arena::current() = m_previous;
+        if (m_arena)
+            m_arena->leave(m_frame);
+    }
+
+private:
+    Arena* m_arena;
+    Arena* m_previous;
+    Arena::Frame m_frame {};
+};
+
+/*
+ * Allocator that takes memory from the arena current when it was created, or from the
+ * heap if there was none. Deallocating arena memory only updates the count of values
+ * alive in the scope it was allocated in.
+ *
+ * Copies of a container bind to the arena current at the time of copying, and moving
+ * or swapping storage only happens between containers bound to the same arena, with
+ * elements copied otherwise.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    ArenaAllocator() noexcept : m_arena {Arena::current()} {}
+    explicit ArenaAllocator(Arena* arena) noexcept : m_arena {arena} {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena {other.arena()} {}
+
+    T* allocate(std::size_t n)
+    {
+        if (!m_arena)
+            return std::allocator<T> {}.allocate(n);
+
+        auto* ptr = static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+        m_arena->retain();
+        return ptr;
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        if (!m_arena)
+            std::allocator<T> {}.deallocate(ptr, n);
+        else
+            m_arena->release(ptr);
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const { return {}; }
+
+    Arena* arena() const noexcept { return m_arena; }
+
+    friend bool operator==(const ArenaAllocator& a, const ArenaAllocator& b) noexcept
+    {
+        return a.m_arena == b.m_arena;
+    }
+    friend bool operator!=(const ArenaAllocator& a, const ArenaAllocator& b) noexcept
+    {
+        return a.m_arena != b.m_arena;
+    }
+
+private:
+    Arena* m_arena;
+};
+
+#endif //PROJECT_EULER_CPP_ARENA_H
@@ -0,0 +1,132 @@
+#include "big-int-accumulator.h"
+
+#include "../../doctest/doctest.h"
+
+namespace {
+    // additions of limbs below 1e9 that a carried limb can take, with half of its range
+    // left free so that propagating the carries cannot overflow either
+    constexpr std::uint64_t maxPending {UINT64_MAX / 1'000'000'000uLL / 2};
+}
+
+BigIntAccumulator& BigIntAccumulator::operator+=(const BigInt& value)
+{
+    const BigInt::LimbView limbs {value};
+    prepare(limbs.size);
+    for (std::size_t i {0}; i < limbs.size; ++i) {
+        m_limbs[i] += limbs[i];
+    }
+
+    return *this;
+}
+
+/*
+ * Splits the string into limbs of 9 digits each, starting from the least significant
+ * end, and adds every limb without carrying.
+ *
+ * @throws std::invalid_argument if the string is empty or contains non-digits.
+ */
+void BigIntAccumulator::add(const char* value, std::size_t size)
+{
+    if (!size)
+        throw std::invalid_argument("String must represent a number");
+    for (std::size_t i {0}; i < size; ++i) {
+        if (!isdigit(value[i]))
+            throw std::invalid_argument("String must represent a number");
+    }
+
+    prepare((size + BigInt::BASE_DIGITS - 1) / BigInt::BASE_DIGITS);
+    auto* limb = m_limbs.data();
+    for (auto end = static_cast<std::ptrdiff_t>(size); end > 0; end -= BigInt::BASE_DIGITS) {
+        auto start = std::max(std::ptrdiff_t {0}, end - BigInt::BASE_DIGITS);
+        std::uint32_t chunk {};
+        for (auto i = start; i < end; ++i) {
+            chunk = chunk * 10 + (value[i] - '0');
+        }
+        *limb++ += chunk;
+    }
+}
+
+void BigIntAccumulator::prepare(std::size_t size)
+{
+    if (++m_pending > maxPending) {
+        propagate(m_limbs);
+        m_pending = 1;
+    }
+    if (m_limbs.size() < size)
+        m_limbs.resize(size, 0);
+}
+
+void BigIntAccumulator::propagate(std::vector<std::uint64_t>& limbs)
+{
+    std::uint64_t carryOver {};
+    for (auto& limb : limbs) {
+        // cannot overflow, as the carry is at most a limb's value divided by 1e9
+        const auto current = limb + carryOver;
+        limb = current % BigInt::BASE;
+        carryOver = current / BigInt::BASE;
+    }
+    while (carryOver) {
+        limbs.push_back(carryOver % BigInt::BASE);
+        carryOver /= BigInt::BASE;
+    }
+}
+
+/*
+ * Carries are propagated on a copy, so that reading the sum between additions does not
+ * change the state of the accumulator.
+ */
+BigInt BigIntAccumulator::value() const
+{
+    if (m_limbs.empty())
+        return BigInt::zero();
+
+    auto carried = m_limbs;
+    propagate(carried);
+
+    return BigInt {BigInt::Limbs(carried.cbegin(), carried.cend())};
+}
+
+TEST_SUITE("test BigIntAccumulator") {
+    TEST_CASE("when empty") {
+        const BigIntAccumulator sum;
+
+        CHECK_EQ(BigInt::zero(), sum.value());
+        CHECK_EQ("0", sum.leadingDigits(10));
+    }
+
+    TEST_CASE("with strings and BigInt values") {
+        BigIntAccumulator sum;
+        sum += "999999999999999999999999999";
+        sum += std::string {"1"};
+        sum += BigInt {"123456789012345678901234567890"};
+        sum += "0000000000000000000000000000000000000005";
+
+        const BigInt expected {"124456789012345678901234567895"};
+        CHECK_EQ(expected, sum.value());
+        CHECK_EQ("1244567890", sum.leadingDigits(10));
+        CHECK_EQ(expected.toString(), sum.leadingDigits(100));
+    }
+
+    TEST_CASE("with invalid string") {
+        BigIntAccumulator sum;
+
+        CHECK_THROWS_AS(sum += "", std::invalid_argument);
+        CHECK_THROWS_AS(sum += "12a4", std::invalid_argument);
+    }
+
+    TEST_CASE("agrees with BigInt addition") {
+        BigIntAccumulator sum;
+        BigInt expected;
+        std::string number(50, '9');
+        for (int i {0}; i < 1000; ++i) {
+            number[i % 50] = static_cast<char>('0' + i % 10);
+            sum += number;
+            expected += BigInt {number};
+        }
+
+        CHECK_EQ(expected, sum.value());
+        // reading the sum leaves the accumulator unchanged
+        sum += "1";
+        CHECK_EQ(expected + BigInt::one(), sum.value());
+    }
+}
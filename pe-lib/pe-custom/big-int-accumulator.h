@@ -0,0 +1,57 @@
+#ifndef PROJECT_EULER_CPP_BIG_INT_ACCUMULATOR_H
+#define PROJECT_EULER_CPP_BIG_INT_ACCUMULATOR_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "big-int.h"
+
+/*
+ * Running sum of many non-negative numbers, for when only the total is needed.
+ *
+ * Values are added into 64-bit limbs in the same base 1e9 as BigInt, but without
+ * propagating carries, so every addition is a single pass with no data dependency
+ * between limbs. A limb can absorb around 9e9 limb-sized additions before it could
+ * overflow, so carries are only propagated once that many values have been added, or
+ * when the sum is read.
+ *
+ * Decimal strings are split into limbs directly, so no BigInt is built per value.
+ */
+class BigIntAccumulator {
+public:
+    /*
+     * @throws std::invalid_argument if the string is empty or contains non-digits.
+     */
+    BigIntAccumulator& operator+=(const std::string& value)
+    {
+        add(value.data(), value.size());
+        return *this;
+    }
+    BigIntAccumulator& operator+=(const char* value)
+    {
+        add(value, strlen(value));
+        return *this;
+    }
+    BigIntAccumulator& operator+=(const BigInt& value);
+
+    BigInt value() const;
+    /*
+     * @return the first k digits of the sum, or all digits if there are fewer.
+     */
+    std::string leadingDigits(std::size_t k) const { return value().leadingDigits(k); }
+
+private:
+    // least significant limb first, each possibly holding uncarried sums above 1e9
+    std::vector<std::uint64_t> m_limbs;
+    // additions since carries were last propagated
+    std::uint64_t m_pending {};
+
+    void add(const char* value, std::size_t size);
+    // makes room for 1 more addition of limbs below 1e9, then for size limbs of it
+    void prepare(std::size_t size);
+    static void propagate(std::vector<std::uint64_t>& limbs);
+};
+
+#endif //PROJECT_EULER_CPP_BIG_INT_ACCUMULATOR_H
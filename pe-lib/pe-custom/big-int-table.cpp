@@ -0,0 +1,205 @@
+#include "big-int-table.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BIG_INT_TABLE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../../doctest/doctest.h"
+
+namespace {
+    constexpr char tableTag[8] {'P', 'E', 'B', 'I', 'G', 'T', 'B', '1'};
+    constexpr std::size_t headerBytes {16};
+
+    void appendLittleEndian(std::string& bytes, std::uint64_t word, int size)
+    {
+        for (int i {0}; i < size; ++i, word >>= 8) {
+            bytes.push_back(static_cast<char>(word & 0xFF));
+        }
+    }
+}
+
+/*
+ * The whole table is built in memory first, as its offsets precede the limbs.
+ */
+void BigIntTableView::write(const std::string& path, const std::vector<BigInt>& values)
+{
+    std::uint64_t totalLimbs {};
+    for (const auto& value : values) {
+        totalLimbs += BigInt::LimbView {value}.size;
+    }
+
+    std::string bytes(tableTag, sizeof tableTag);
+    bytes.reserve(headerBytes + 8 * (values.size() + 1) + 4 * totalLimbs);
+    appendLittleEndian(bytes, values.size(), 8);
+    std::uint64_t offset {};
+    appendLittleEndian(bytes, offset, 8);
+    for (const auto& value : values) {
+        offset += BigInt::LimbView {value}.size;
+        appendLittleEndian(bytes, offset, 8);
+    }
+    for (const auto& value : values) {
+        const BigInt::LimbView limbs {value};
+        for (std::size_t i {0}; i < limbs.size; ++i) {
+            appendLittleEndian(bytes, limbs[i], 4);
+        }
+    }
+
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+    if (!file.write(bytes.data(), static_cast<std::streamsize>(bytes.size())))
+        throw std::runtime_error("Cannot write BigInt table to " + path);
+}
+
+/*
+ * The mapped words are read in place, which requires a little-endian host.
+ */
+BigIntTableView::BigIntTableView(const std::string& path)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    throw std::runtime_error("BigInt tables can only be mapped on little-endian hosts");
+#endif
+
+#ifdef BIG_INT_TABLE_MMAP
+    const auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        throw std::runtime_error("Cannot open BigInt table " + path);
+    struct stat status {};
+    if (::fstat(descriptor, &status) < 0 || status.st_size < 0) {
+        ::close(descriptor);
+        throw std::runtime_error("Cannot read BigInt table " + path);
+    }
+    m_bytes = static_cast<std::size_t>(status.st_size);
+    if (m_bytes) {
+        auto* mapped = ::mmap(nullptr, m_bytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        // the mapping stays valid once the descriptor is closed
+        ::close(descriptor);
+        if (mapped == MAP_FAILED)
+            throw std::runtime_error("Cannot map BigInt table " + path);
+        m_data = static_cast<const char*>(mapped);
+    }
+    else {
+        ::close(descriptor);
+    }
+#else
+    std::ifstream file {path, std::ios::binary};
+    if (!file)
+        throw std::runtime_error("Cannot open BigInt table " + path);
+    m_buffer.assign(std::istreambuf_iterator<char> {file}, {});
+    m_data = m_buffer.data();
+    m_bytes = m_buffer.size();
+#endif
+
+    auto invalid = [this, &path]() {
+        unmap();
+        return std::runtime_error("Invalid BigInt table " + path);
+    };
+    if (m_bytes < headerBytes || std::memcmp(m_data, tableTag, sizeof tableTag))
+        throw invalid();
+    std::uint64_t size;
+    std::memcpy(&size, m_data + sizeof tableTag, 8);
+    // checked against the file size before multiplying, so that it cannot overflow
+    if (size >= (m_bytes - headerBytes) / 8)
+        throw invalid();
+
+    m_size = size;
+    m_offsets = reinterpret_cast<const std::uint64_t*>(m_data + headerBytes);
+    m_limbs = reinterpret_cast<const std::uint32_t*>(m_offsets + m_size + 1);
+    const auto limbBytes = m_bytes - headerBytes - 8 * (m_size + 1);
+    if (m_offsets[0] || m_offsets[m_size] != limbBytes / 4 || limbBytes % 4)
+        throw invalid();
+    for (std::size_t i {0}; i < m_size; ++i) {
+        if (m_offsets[i+1] <= m_offsets[i])
+            throw invalid();
+    }
+}
+
+BigIntTableView::~BigIntTableView()
+{
+    unmap();
+}
+
+void BigIntTableView::unmap()
+{
+#ifdef BIG_INT_TABLE_MMAP
+    if (m_data)
+        ::munmap(const_cast<char*>(m_data), m_bytes);
+#endif
+    m_data = nullptr;
+}
+
+BigIntView BigIntTableView::at(std::size_t i) const
+{
+    if (i >= m_size)
+        throw std::out_of_range("BigInt table index out of range");
+
+    return (*this)[i];
+}
+
+TEST_SUITE("test BigIntTableView") {
+    const auto path = (std::filesystem::temp_directory_path() / "big-int-table.bin").string();
+
+    TEST_CASE("values read back through views") {
+        std::vector<BigInt> factorials {BigInt::one()};
+        for (unsigned long long i {1}; i <= 200; ++i) {
+            factorials.push_back(factorials.back() * i);
+        }
+        BigIntTableView::write(path, factorials);
+        const BigIntTableView table {path};
+
+        REQUIRE_EQ(factorials.size(), table.size());
+        for (std::size_t i {0}; i < table.size(); ++i) {
+            CHECK_EQ(factorials[i], table[i]);
+            CHECK_EQ(table[i], factorials[i]);
+            CHECK_EQ(factorials[i].toString(), table[i].toString());
+            CHECK_EQ(factorials[i], table[i].toBigInt());
+        }
+        CHECK_LT(table[20], table[21]);
+        CHECK_GT(table[21], factorials[20]);
+        CHECK_LE(factorials[20], table[20]);
+        CHECK_NE(table[20], table[21]);
+        CHECK_THROWS_AS(table.at(201), std::out_of_range);
+    }
+
+    TEST_CASE("views as right operands") {
+        const std::vector<BigInt> values {BigInt {"123456789012345678901234567890"},
+                                          BigInt {7uLL}, BigInt::zero()};
+        BigIntTableView::write(path, values);
+        const BigIntTableView table {path};
+        const BigInt x {"999999999999999999999999999999999"};
+
+        CHECK_EQ(x + values[0], x + table[0]);
+        CHECK_EQ(x - values[0], x - table[0]);
+        CHECK_EQ(x * values[0], x * table[0]);
+        CHECK_EQ(x / values[0], x / table[0]);
+        CHECK_EQ(x % values[0], x % table[0]);
+        CHECK_EQ(BigInt {14uLL}, BigInt {7uLL} + table[1]);
+        CHECK_EQ(BigInt::zero(), BigInt {7uLL} - table[1]);
+        CHECK_EQ(x, x + table[2]);
+        CHECK_THROWS_AS(BigInt {6uLL} - table[1], std::invalid_argument);
+        CHECK_THROWS_AS(x / table[2], std::runtime_error);
+
+        BigInt sum;
+        for (std::size_t i {0}; i < table.size(); ++i) {
+            sum += table[i];
+        }
+        CHECK_EQ(values[0] + values[1], sum);
+    }
+
+    TEST_CASE("empty and invalid tables") {
+        BigIntTableView::write(path, {});
+        CHECK_EQ(0, BigIntTableView {path}.size());
+
+        std::ofstream {path, std::ios::binary} << "not a table";
+        CHECK_THROWS_AS(BigIntTableView {path}, std::runtime_error);
+        CHECK_THROWS_AS(BigIntTableView {path + ".missing"}, std::runtime_error);
+        std::filesystem::remove(path);
+    }
+}
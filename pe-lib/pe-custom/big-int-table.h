@@ -0,0 +1,142 @@
+#ifndef PROJECT_EULER_CPP_BIG_INT_TABLE_H
+#define PROJECT_EULER_CPP_BIG_INT_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "big-int.h"
+
+/*
+ * Read-only handle to the limbs of a number stored elsewhere, e.g. in a memory-mapped
+ * BigIntTableView, that never copies them unless converted to a BigInt.
+ *
+ * Views compare with each other & with BigInt, and can be the right operand of BigInt
+ * arithmetic. Addition, subtraction & comparison read the limbs in place, whereas
+ * multiplication & division copy them once, which is negligible next to the operation.
+ *
+ * A view is only valid for as long as the storage it was taken from.
+ */
+class BigIntView {
+public:
+    // limbs must be trimmed base 1e9 limbs, least significant first
+    BigIntView(const std::uint32_t* limbs, std::size_t size)
+        : m_limbs {limbs}, m_size {size} {}
+
+    BigInt toBigInt() const { return BigInt {BigInt::Limbs(m_limbs, m_limbs + m_size)}; }
+    std::string toString() const { return BigInt::toString(m_limbs, m_size); }
+
+    friend bool operator==(BigIntView a, BigIntView b) { return !compare(a, b); }
+    friend bool operator!=(BigIntView a, BigIntView b) { return compare(a, b); }
+    friend bool operator<(BigIntView a, BigIntView b) { return compare(a, b) < 0; }
+    friend bool operator>(BigIntView a, BigIntView b) { return compare(a, b) > 0; }
+    friend bool operator<=(BigIntView a, BigIntView b) { return compare(a, b) <= 0; }
+    friend bool operator>=(BigIntView a, BigIntView b) { return compare(a, b) >= 0; }
+    // a BigInt is compared as a view of its own limbs, which an inline value splits into
+    friend bool operator==(const BigInt& a, BigIntView b) { return !compare(a, b); }
+    friend bool operator!=(const BigInt& a, BigIntView b) { return compare(a, b); }
+    friend bool operator<(const BigInt& a, BigIntView b) { return compare(a, b) < 0; }
+    friend bool operator>(const BigInt& a, BigIntView b) { return compare(a, b) > 0; }
+    friend bool operator<=(const BigInt& a, BigIntView b) { return compare(a, b) <= 0; }
+    friend bool operator>=(const BigInt& a, BigIntView b) { return compare(a, b) >= 0; }
+    friend bool operator==(BigIntView a, const BigInt& b) { return b == a; }
+    friend bool operator!=(BigIntView a, const BigInt& b) { return b != a; }
+    friend bool operator<(BigIntView a, const BigInt& b) { return b > a; }
+    friend bool operator>(BigIntView a, const BigInt& b) { return b < a; }
+    friend bool operator<=(BigIntView a, const BigInt& b) { return b >= a; }
+    friend bool operator>=(BigIntView a, const BigInt& b) { return b <= a; }
+
+    friend BigInt& operator+=(BigInt& a, BigIntView b)
+    {
+        add(a, b);
+        return a;
+    }
+    friend BigInt operator+(BigInt a, BigIntView b) { return std::move(a += b); }
+    /*
+     * @throws std::invalid_argument if b > a.
+     */
+    friend BigInt& operator-=(BigInt& a, BigIntView b)
+    {
+        subtract(a, b);
+        return a;
+    }
+    friend BigInt operator-(BigInt a, BigIntView b) { return std::move(a -= b); }
+    friend BigInt& operator*=(BigInt& a, BigIntView b) { return a *= b.toBigInt(); }
+    friend BigInt operator*(const BigInt& a, BigIntView b) { return a * b.toBigInt(); }
+    friend BigInt& operator/=(BigInt& a, BigIntView b) { return a /= b.toBigInt(); }
+    friend BigInt operator/(const BigInt& a, BigIntView b) { return a / b.toBigInt(); }
+    friend BigInt& operator%=(BigInt& a, BigIntView b) { return a %= b.toBigInt(); }
+    friend BigInt operator%(const BigInt& a, BigIntView b) { return a % b.toBigInt(); }
+
+private:
+    const std::uint32_t* m_limbs;
+    std::size_t m_size;
+
+    static void add(BigInt& a, BigIntView b) { BigInt::addLimbs(a, b.m_limbs, b.m_size); }
+    static void subtract(BigInt& a, BigIntView b)
+    {
+        BigInt::subLimbs(a, b.m_limbs, b.m_size);
+    }
+    static int compare(BigIntView a, BigIntView b)
+    {
+        return BigInt::compare(a.m_limbs, a.m_size, b.m_limbs, b.m_size);
+    }
+    static int compare(const BigInt& a, BigIntView b)
+    {
+        const BigInt::LimbView aV {a};
+        return BigInt::compare(aV.data, aV.size, b.m_limbs, b.m_size);
+    }
+};
+
+/*
+ * Read-only table of numbers in a file that is memory-mapped, so that opening it costs
+ * nothing until values are read, with each read only faulting in the pages it touches.
+ *
+ * The file holds, all little-endian:
+ *
+ *      - an 8-byte tag, then the 64-bit amount of values n,
+ *      - n + 1 64-bit offsets, in limbs, of the start of each value & of the end,
+ *      - the base 1e9 limbs of every value, as 32-bit words, least significant first.
+ *
+ * Only this structure is checked on opening, as checking every limb would read the
+ * whole file, so files are expected to have been written by write().
+ */
+class BigIntTableView {
+public:
+    /*
+     * @throws std::runtime_error if the file cannot be read or is not a table.
+     */
+    explicit BigIntTableView(const std::string& path);
+    BigIntTableView(const BigIntTableView&) = delete;
+    BigIntTableView& operator=(const BigIntTableView&) = delete;
+    ~BigIntTableView();
+
+    /*
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    static void write(const std::string& path, const std::vector<BigInt>& values);
+
+    std::size_t size() const { return m_size; }
+    BigIntView operator[](std::size_t i) const
+    {
+        const auto from = m_offsets[i];
+        return {m_limbs + from, static_cast<std::size_t>(m_offsets[i+1] - from)};
+    }
+    /*
+     * @throws std::out_of_range if i >= size().
+     */
+    BigIntView at(std::size_t i) const;
+
+private:
+    const char* m_data {};
+    std::size_t m_bytes {};
+    std::size_t m_size {};
+    const std::uint64_t* m_offsets {};
+    const std::uint32_t* m_limbs {};
+    // the file contents, where memory mapping is not available
+    std::vector<char> m_buffer;
+
+    void unmap();
+};
+
+#endif //PROJECT_EULER_CPP_BIG_INT_TABLE_H
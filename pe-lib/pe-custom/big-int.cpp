@@ -1,55 +1,626 @@
 #include "big-int.h"
 
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIG_INT_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include "uint.h"
+
 #include "../../doctest/doctest.h"
+#include "../pe-tests/count-allocations.h"
+
+/*
+ * Parses a string of decimal digits into limbs of 9 digits each, starting from the
+ * least significant end of the string.
+ *
+ * @throws std::invalid_argument if the string is empty or contains non-digits.
+ */
+void BigInt::assign(const char* value, std::size_t size)
+{
+    if (!size)
+        throw std::invalid_argument("String must represent a number");
+    for (std::size_t i {0}; i < size; ++i) {
+        if (!isdigit(value[i]))
+            throw std::invalid_argument("String must represent a number");
+    }
+
+    // up to 18 digits always fit in a native word
+    if (size <= 2 * BASE_DIGITS) {
+        std::uint64_t word {};
+        for (std::size_t i {0}; i < size; ++i) {
+            word = word * 10 + (value[i] - '0');
+        }
+        assignWord(word);
+        return;
+    }
 
-// friend modifier negates need for syntax BigInt::operator==()
-bool operator==(const BigInt& a, const BigInt& b) { return a.m_digits == b.m_digits; }
-bool operator!=(const BigInt& a, const BigInt& b) { return !(a == b); }
-bool operator<(const BigInt& a, const BigInt& b)
+    m_limbs.clear();
+    m_limbs.reserve(size / BASE_DIGITS + 1);
+    for (auto end = static_cast<std::ptrdiff_t>(size); end > 0; end -= BASE_DIGITS) {
+        auto start = std::max(std::ptrdiff_t {0}, end - BASE_DIGITS);
+        std::uint32_t limb {};
+        for (auto i = start; i < end; ++i) {
+            limb = limb * 10 + (value[i] - '0');
+        }
+        m_limbs.push_back(limb);
+    }
+    normalise();
+}
+
+/*
+ * Limbs are only taken over from a value bound to the same arena, or to the heap if this
+ * value is too, as the allocators do not propagate on move assignment. The moved-from
+ * value is left with the old storage of this one, but emptied, so that its cached
+ * fingerprint can never describe limbs that it no longer holds.
+ */
+BigInt& BigInt::operator=(BigInt&& rhs)
 {
-    std::size_t aS = a.length(), bS = b.length();
-    if (aS != bS)
-        return aS < bS;
+    if (this == &rhs)
+        return *this;
+
+    if (m_limbs.get_allocator() == rhs.m_limbs.get_allocator()) {
+        m_limbs.swap(rhs.m_limbs);
+        rhs.m_limbs.clear();
+    }
+    else {
+        m_limbs.assign(rhs.m_limbs.cbegin(), rhs.m_limbs.cend());
+    }
+    m_small = rhs.m_small;
+    m_fingerprint = rhs.m_fingerprint;
+    return *this;
+}
+
+namespace {
+    // "00" to "99", so that a limb is written 2 digits per division
+    constexpr auto digitPairs = [] {
+        std::array<char, 200> pairs {};
+        for (int i {0}; i < 100; ++i) {
+            pairs[2*i] = static_cast<char>('0' + i / 10);
+            pairs[2*i+1] = static_cast<char>('0' + i % 10);
+        }
+        return pairs;
+    }();
+
+    // digit sums of 0 to 9999, so that a limb is summed 4 digits per lookup
+    constexpr auto digitSums = [] {
+        std::array<std::uint8_t, 10'000> sums {};
+        for (int i {1}; i < 10'000; ++i) {
+            sums[i] = static_cast<std::uint8_t>(sums[i / 10] + i % 10);
+        }
+        return sums;
+    }();
+
+    // writes a limb as exactly 9 zero-padded digits, ending just before end
+    void writeLimb(char* end, std::uint32_t limb)
+    {
+        for (int d {0}; d < 4; ++d) {
+            const auto pair = limb % 100;
+            limb /= 100;
+            *--end = digitPairs[2*pair+1];
+            *--end = digitPairs[2*pair];
+        }
+        *--end = static_cast<char>('0' + limb);
+    }
+}
+
+/*
+ * As limbs are decimal, conversion is a single linear pass, with every limb below the
+ * most significant one zero-padded to 9 digits.
+ */
+std::string BigInt::toString() const
+{
+    if (isSmall())
+        return std::to_string(m_small);
+
+    return toString(m_limbs.data(), m_limbs.size());
+}
+std::string BigInt::toString(const std::uint32_t* limbs, std::size_t size)
+{
+    std::string result = std::to_string(limbs[size-1]);
+    const auto topS = result.size();
+    result.resize(topS + (size - 1) * BASE_DIGITS);
+
+    auto* pos = result.data() + result.size();
+    for (std::size_t i {0}; i < size - 1; ++i, pos -= BASE_DIGITS) {
+        writeLimb(pos, limbs[i]);
+    }
+
+    return result;
+}
+
+/*
+ * Only converts the limbs that contain the requested digits.
+ */
+std::string BigInt::leadingDigits(std::size_t k) const
+{
+    const auto digits = length();
+    if (k >= digits)
+        return toString();
+    if (isSmall())
+        return toString().substr(0, k);
+
+    std::string result = std::to_string(m_limbs.back());
+    const auto topS = result.size();
+    const auto limbs = k > topS ? (k - topS + BASE_DIGITS - 1) / BASE_DIGITS : 0;
+    result.resize(topS + limbs * BASE_DIGITS);
+
+    auto* pos = result.data() + topS;
+    for (std::size_t i {1}; i <= limbs; ++i) {
+        pos += BASE_DIGITS;
+        writeLimb(pos, m_limbs[m_limbs.size()-1-i]);
+    }
+    result.resize(k);
+
+    return result;
+}
+
+unsigned long BigInt::digitSum() const
+{
+    unsigned long sum {};
+    if (isSmall()) {
+        for (auto value = m_small; value; value /= 10'000) {
+            sum += digitSums[value % 10'000];
+        }
+        return sum;
+    }
+
+    for (const auto limb : m_limbs) {
+        sum += digitSums[limb % 10'000] + digitSums[limb / 10'000 % 10'000] +
+                limb / 100'000'000;
+    }
+
+    return sum;
+}
+
+unsigned long BigInt::toULong() const
+{
+    const auto value = toULLong();
+    if (value > std::numeric_limits<unsigned long>::max())
+        throw std::out_of_range("BigInt exceeds unsigned long range");
+
+    return static_cast<unsigned long>(value);
+}
+
+unsigned long long BigInt::toULLong() const
+{
+    if (isSmall())
+        return m_small;
+
+    const auto max = std::numeric_limits<unsigned long long>::max();
+    unsigned long long value {};
+    for (std::size_t i = m_limbs.size(); i--;) {
+        if (value > (max - m_limbs[i]) / BASE)
+            throw std::out_of_range("BigInt exceeds unsigned long long range");
+        value = value * BASE + m_limbs[i];
+    }
+
+    return value;
+}
 
-    while (aS--) {
-        if (a.m_digits[aS] != b.m_digits[aS])
-            return a.m_digits[aS] < b.m_digits[aS];
+namespace {
+    void storeLittleEndian(char* bytes, std::uint32_t word)
+    {
+        for (int i {0}; i < 4; ++i, word >>= 8) {
+            bytes[i] = static_cast<char>(word & 0xFF);
+        }
+    }
+
+    std::uint32_t loadLittleEndian(const char* bytes)
+    {
+        std::uint32_t word {};
+        for (int i {4}; i--;) {
+            word = word << 8 | static_cast<unsigned char>(bytes[i]);
+        }
+        return word;
+    }
+}
+
+/*
+ * Limbs are written byte by byte, so the format is the same on every host.
+ */
+void BigInt::serialise(std::ostream& out) const
+{
+    const LimbView limbs {*this};
+    std::string bytes(4 * (limbs.size + 1), '\0');
+    storeLittleEndian(bytes.data(), static_cast<std::uint32_t>(limbs.size));
+    for (std::size_t i {0}; i < limbs.size; ++i) {
+        storeLittleEndian(bytes.data() + 4 * (i + 1), limbs[i]);
+    }
+
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+BigInt BigInt::deserialise(std::istream& in)
+{
+    char header[4];
+    if (!in.read(header, 4))
+        throw std::runtime_error("Serialised BigInt is truncated");
+    const auto size = loadLittleEndian(header);
+    if (!size)
+        throw std::runtime_error("Serialised BigInt has no limbs");
+
+    std::string bytes(4 * static_cast<std::size_t>(size), '\0');
+    if (!in.read(bytes.data(), static_cast<std::streamsize>(bytes.size())))
+        throw std::runtime_error("Serialised BigInt is truncated");
+
+    Limbs limbs(size);
+    for (std::size_t i {0}; i < size; ++i) {
+        limbs[i] = loadLittleEndian(bytes.data() + 4 * i);
+        if (limbs[i] >= BASE)
+            throw std::runtime_error("Serialised BigInt has an invalid limb");
+    }
+    if (size > 1 && !limbs.back())
+        throw std::runtime_error("Serialised BigInt has leading zero limbs");
+
+    return BigInt {std::move(limbs)};
+}
+
+namespace {
+    // SplitMix64 finaliser, so that every input bit affects every output bit
+    std::uint64_t mix(std::uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58'476D'1CE4'E5B9uLL;
+        x = (x ^ (x >> 27)) * 0x94D0'49BB'1331'11EBuLL;
+        return x ^ (x >> 31);
+    }
+}
+
+/*
+ * Limbs are combined 2 at a time as 64-bit words, with a multiply & rotate per word,
+ * seeded by the amount of limbs. Inline values are only mixed, which is cheaper than
+ * reading the cache, so only fingerprints of limbs are cached.
+ */
+std::uint64_t BigInt::fingerprint() const
+{
+    if (isSmall())
+        return mix(m_small);
+    if (const auto cached = m_fingerprint.load())
+        return cached;
+
+    const auto size = m_limbs.size();
+    std::uint64_t hash {mix(size)};
+    std::size_t i {0};
+    for (; i + 1 < size; i += 2) {
+        const auto word = m_limbs[i] | std::uint64_t {m_limbs[i+1]} << 32;
+        hash = (hash ^ word) * 0x9E37'79B9'7F4A'7C15uLL;
+        hash = hash << 31 | hash >> 33;
+    }
+    if (i < size)
+        hash = (hash ^ m_limbs[i]) * 0x9E37'79B9'7F4A'7C15uLL;
+    hash = mix(hash);
+
+    // 0 marks an empty cache, so is never stored
+    hash = hash ? hash : 1;
+    m_fingerprint.store(hash);
+    return hash;
+}
+
+namespace limbs {
+    // same as BigInt::BASE, which is not accessible outside the class
+    constexpr std::uint32_t base {1'000'000'000};
+
+    /*
+     * Kernels over n limbs of equal length, with the shorter operand's range handled by
+     * the caller. Each has a scalar version and, on x86, SSE4.1 & AVX2 versions that are
+     * selected once at runtime based on the CPU.
+     *
+     * Vector lanes cannot ripple a carry into each other, so every lane first reports
+     * whether it generates a carry (the sum is at least 1e9) or would propagate an
+     * incoming one (the sum is exactly 1e9 - 1), as bit masks. Adding the propagate mask
+     * to the shifted generate mask then ripples every carry through its run of
+     * propagating lanes in a single native addition, as in a carry-lookahead adder.
+     */
+
+    // a += b + carry over n limbs, @return the carry out of the top limb
+    std::uint32_t addScalar(std::uint32_t* a, const std::uint32_t* b, std::size_t n,
+                            std::uint32_t carry)
+    {
+        for (std::size_t i {0}; i < n; ++i) {
+            const auto sum = a[i] + b[i] + carry;
+            carry = sum >= base;
+            a[i] = carry ? sum - base : sum;
+        }
+
+        return carry;
+    }
+
+    // a -= b + borrow over n limbs, @return the borrow out of the top limb
+    std::uint32_t subScalar(std::uint32_t* a, const std::uint32_t* b, std::size_t n,
+                            std::uint32_t borrow)
+    {
+        for (std::size_t i {0}; i < n; ++i) {
+            const auto sub = b[i] + borrow;
+            borrow = a[i] < sub;
+            a[i] = borrow ? a[i] + base - sub : a[i] - sub;
+        }
+
+        return borrow;
+    }
+
+    // compares n limbs from the most significant, like std::memcmp
+    int compareScalar(const std::uint32_t* a, const std::uint32_t* b, std::size_t n)
+    {
+        while (n--) {
+            if (a[n] != b[n])
+                return a[n] < b[n] ? -1 : 1;
+        }
+
+        return 0;
+    }
+
+#ifdef BIG_INT_X86_KERNELS
+    // @return mask with bit i set for every lane i that holds the carry into it
+    inline unsigned carriesIn(unsigned generate, unsigned propagate, std::uint32_t carry)
+    {
+        return (((generate << 1) | carry) + propagate) ^ propagate;
+    }
+
+    __attribute__((target("sse4.1")))
+    std::uint32_t addSSE4(std::uint32_t* a, const std::uint32_t* b, std::size_t n,
+                          std::uint32_t carry)
+    {
+        const auto top = _mm_set1_epi32(base - 1), baseV = _mm_set1_epi32(base);
+        const auto lanes = _mm_setr_epi32(1, 2, 4, 8);
+        std::size_t i {0};
+        for (; i + 4 <= n; i += 4) {
+            auto* pA = reinterpret_cast<__m128i*>(a + i);
+            auto sum = _mm_add_epi32(_mm_loadu_si128(pA), _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(b + i)));
+            const auto carries = carriesIn(
+                    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(sum, top))),
+                    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(sum, top))), carry);
+            carry = carries >> 4 & 1;
+            // every lane holding a carry becomes all ones, i.e. -1, so is subtracted
+            const auto inLanes = _mm_and_si128(_mm_set1_epi32(carries), lanes);
+            sum = _mm_sub_epi32(sum, _mm_cmpeq_epi32(inLanes, lanes));
+            // sum - 1e9 wraps around unless the sum is at least 1e9
+            sum = _mm_min_epu32(sum, _mm_sub_epi32(sum, baseV));
+            _mm_storeu_si128(pA, sum);
+        }
+
+        return addScalar(a + i, b + i, n - i, carry);
+    }
+
+    __attribute__((target("sse4.1")))
+    std::uint32_t subSSE4(std::uint32_t* a, const std::uint32_t* b, std::size_t n,
+                          std::uint32_t borrow)
+    {
+        const auto zero = _mm_setzero_si128(), baseV = _mm_set1_epi32(base);
+        const auto lanes = _mm_setr_epi32(1, 2, 4, 8);
+        std::size_t i {0};
+        for (; i + 4 <= n; i += 4) {
+            auto* pA = reinterpret_cast<__m128i*>(a + i);
+            auto diff = _mm_sub_epi32(_mm_loadu_si128(pA), _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(b + i)));
+            const auto borrows = carriesIn(
+                    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(zero, diff))),
+                    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(diff, zero))), borrow);
+            borrow = borrows >> 4 & 1;
+            const auto inLanes = _mm_and_si128(_mm_set1_epi32(borrows), lanes);
+            diff = _mm_add_epi32(diff, _mm_cmpeq_epi32(inLanes, lanes));
+            // diff + 1e9 is only smaller, as unsigned, if diff is negative
+            diff = _mm_min_epu32(diff, _mm_add_epi32(diff, baseV));
+            _mm_storeu_si128(pA, diff);
+        }
+
+        return subScalar(a + i, b + i, n - i, borrow);
+    }
+
+    __attribute__((target("sse4.1")))
+    int compareSSE4(const std::uint32_t* a, const std::uint32_t* b, std::size_t n)
+    {
+        for (; n >= 4; n -= 4) {
+            const auto equal = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + n - 4)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + n - 4)))));
+            if (equal != 0xF) {
+                const auto i = n - 4 + 31 - __builtin_clz(~equal & 0xF);
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+
+        return compareScalar(a, b, n);
+    }
+
+    __attribute__((target("avx2")))
+    std::uint32_t addAVX2(std::uint32_t* a, const std::uint32_t* b, std::size_t n,
+                          std::uint32_t carry)
+    {
+        const auto top = _mm256_set1_epi32(base - 1), baseV = _mm256_set1_epi32(base);
+        const auto lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        std::size_t i {0};
+        for (; i + 8 <= n; i += 8) {
+            auto* pA = reinterpret_cast<__m256i*>(a + i);
+            auto sum = _mm256_add_epi32(_mm256_loadu_si256(pA), _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(b + i)));
+            const auto carries = carriesIn(
+                    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(sum, top))),
+                    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, top))),
+                    carry);
+            carry = carries >> 8 & 1;
+            const auto inLanes = _mm256_and_si256(_mm256_set1_epi32(carries), lanes);
+            sum = _mm256_sub_epi32(sum, _mm256_cmpeq_epi32(inLanes, lanes));
+            sum = _mm256_min_epu32(sum, _mm256_sub_epi32(sum, baseV));
+            _mm256_storeu_si256(pA, sum);
+        }
+
+        return addSSE4(a + i, b + i, n - i, carry);
+    }
+
+    __attribute__((target("avx2")))
+    std::uint32_t subAVX2(std::uint32_t* a, const std::uint32_t* b, std::size_t n,
+                          std::uint32_t borrow)
+    {
+        const auto zero = _mm256_setzero_si256(), baseV = _mm256_set1_epi32(base);
+        const auto lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        std::size_t i {0};
+        for (; i + 8 <= n; i += 8) {
+            auto* pA = reinterpret_cast<__m256i*>(a + i);
+            auto diff = _mm256_sub_epi32(_mm256_loadu_si256(pA), _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(b + i)));
+            const auto borrows = carriesIn(
+                    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, diff))),
+                    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(diff, zero))),
+                    borrow);
+            borrow = borrows >> 8 & 1;
+            const auto inLanes = _mm256_and_si256(_mm256_set1_epi32(borrows), lanes);
+            diff = _mm256_add_epi32(diff, _mm256_cmpeq_epi32(inLanes, lanes));
+            diff = _mm256_min_epu32(diff, _mm256_add_epi32(diff, baseV));
+            _mm256_storeu_si256(pA, diff);
+        }
+
+        return subSSE4(a + i, b + i, n - i, borrow);
     }
 
-    return false;
+    __attribute__((target("avx2")))
+    int compareAVX2(const std::uint32_t* a, const std::uint32_t* b, std::size_t n)
+    {
+        for (; n >= 8; n -= 8) {
+            const auto equal = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + n - 8)),
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + n - 8)))));
+            if (equal != 0xFF) {
+                const auto i = n - 8 + 31 - __builtin_clz(~equal & 0xFF);
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+
+        return compareSSE4(a, b, n);
+    }
+#endif
+
+    enum class Level { SCALAR, SSE4, AVX2 };
+
+    Level detectLevel()
+    {
+#ifdef BIG_INT_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return Level::AVX2;
+        if (__builtin_cpu_supports("sse4.1"))
+            return Level::SSE4;
+#endif
+        return Level::SCALAR;
+    }
+
+    // the kernels used by BigInt, which tests may switch to compare implementations
+    struct Kernels {
+        std::uint32_t (*add)(std::uint32_t*, const std::uint32_t*, std::size_t,
+                             std::uint32_t);
+        std::uint32_t (*sub)(std::uint32_t*, const std::uint32_t*, std::size_t,
+                             std::uint32_t);
+        int (*compare)(const std::uint32_t*, const std::uint32_t*, std::size_t);
+    };
+
+    Kernels kernelsFor(Level level)
+    {
+        switch (level) {
+#ifdef BIG_INT_X86_KERNELS
+            case Level::AVX2:
+                return {addAVX2, subAVX2, compareAVX2};
+            case Level::SSE4:
+                return {addSSE4, subSSE4, compareSSE4};
+#endif
+            default:
+                return {addScalar, subScalar, compareScalar};
+        }
+    }
+
+    Kernels kernels = kernelsFor(detectLevel());
+}
+
+/*
+ * @return negative value if a < b, 0 if a = b, and positive value if a > b.
+ */
+int BigInt::compare(const BigInt& a, const BigInt& b)
+{
+    if (a.isSmall() && b.isSmall())
+        return (a.m_small > b.m_small) - (a.m_small < b.m_small);
+
+    const LimbView aV {a}, bV {b};
+
+    return compare(aV.data, aV.size, bV.data, bV.size);
+}
+int BigInt::compare(const std::uint32_t* a, std::size_t aS,
+                    const std::uint32_t* b, std::size_t bS)
+{
+    if (aS != bS)
+        return aS < bS ? -1 : 1;
+
+    return limbs::kernels.compare(a, b, aS);
 }
+
+// friend modifier negates need for syntax BigInt::operator==()
+bool operator==(const BigInt& a, const BigInt& b)
+{
+    if (a.isSmall() != b.isSmall())
+        return BigInt::compare(a, b) == 0;
+    if (a.isSmall())
+        return a.m_small == b.m_small;
+    // only fingerprints already cached are used, as computing one reads every limb
+    const auto aF = a.m_fingerprint.load(), bF = b.m_fingerprint.load();
+    if (aF && bF && aF != bF)
+        return false;
+
+    return a.m_limbs == b.m_limbs;
+}
+bool operator!=(const BigInt& a, const BigInt& b) { return !(a == b); }
+bool operator<(const BigInt& a, const BigInt& b) { return BigInt::compare(a, b) < 0; }
 bool operator>(const BigInt& a, const BigInt& b) { return b < a; }
 bool operator<=(const BigInt& a, const BigInt& b) { return !(a > b); }
 bool operator>=(const BigInt& a, const BigInt& b) { return !(a < b); }
 
 BigInt& BigInt::operator++()
 {
-    std::size_t aS = length();
-    int i;
-    for (i = 0; i < aS && m_digits[i] == '9'; ++i) {
-        m_digits[i] = '0';
+    if (isSmall()) {
+        assignWord(m_small + 1);
+        return *this;
+    }
+
+    m_fingerprint.store(0);
+    std::size_t aS = m_limbs.size(), i;
+    for (i = 0; i < aS && m_limbs[i] == BASE - 1; ++i) {
+        m_limbs[i] = 0;
     }
     if (i == aS)
-        m_digits.push_back('1');
+        m_limbs.push_back(1);
     else
-        m_digits[i] += 1;
+        m_limbs[i] += 1;
 
     return *this;
 }
 BigInt& BigInt::operator--()
 {
-    if (*this == BigInt::zero()) {
+    if (isZero()) {
         throw std::runtime_error("Negative values not supported");
     }
+    if (isSmall()) {
+        m_small--;
+        return *this;
+    }
 
-    std::size_t aS = length();
-    int i;
-    for (i = 0; i < aS && m_digits[i] == '0'; ++i) {
-        m_digits[i] = '9';
+    std::size_t i;
+    for (i = 0; !m_limbs[i]; ++i) {
+        m_limbs[i] = BASE - 1;
     }
-    m_digits[i] -= 1;
-    if (aS > 1 && m_digits[aS-1] == '0')
-        m_digits.pop_back();
+    m_limbs[i] -= 1;
+    normalise();
 
     return *this;
 }
@@ -68,207 +639,1242 @@ BigInt BigInt::operator--(int temp)
     return aux;
 }
 
-BigInt& operator+=(BigInt& a, const BigInt& b)
+void BigInt::addLimbs(BigInt& a, const std::uint32_t* b, std::size_t bS)
 {
-    std::size_t aS = a.length(), bS = b.length();
+    a.spill();
+    auto aS = a.m_limbs.size();
     if (bS > aS) {  // modified BigInt may be of larger length
-        a.m_digits.resize(bS, '0');
+        a.m_limbs.resize(bS, 0);
         aS = bS;
     }
 
-    unsigned short carryOver {};
-    for (int i {0}, sum; i < aS; ++i) {
-        if (i < bS)
-            sum = (a.m_digits[i] - '0') + (b.m_digits[i] - '0') + carryOver;
-        else  // const BigInt may be of smaller length
-            sum = (a.m_digits[i] - '0') + carryOver;
-        carryOver = sum / 10;
-        a.m_digits[i] = (sum % 10) + '0';
+    auto carryOver = limbs::kernels.add(a.m_limbs.data(), b, bS, 0);
+    // const BigInt may be of smaller length
+    for (auto i = bS; carryOver && i < aS; ++i) {
+        carryOver = a.m_limbs[i] == BASE - 1;
+        a.m_limbs[i] = carryOver ? 0 : a.m_limbs[i] + 1;
     }
     if (carryOver)
-        a.m_digits.push_back(carryOver + '0');
+        a.m_limbs.push_back(carryOver);
+    a.normalise();
+}
+
+void BigInt::subLimbs(BigInt& a, const std::uint32_t* b, std::size_t bS)
+{
+    const LimbView aV {a};
+    if (compare(aV.data, aV.size, b, bS) < 0) {  // BigInt only supports non-negative values
+        throw std::invalid_argument("Attempting to subtract BigInt of greater value");
+    }
+
+    a.spill();
+    const auto aS = a.m_limbs.size();
+    auto borrow = limbs::kernels.sub(a.m_limbs.data(), b, bS, 0);
+    // const BigInt may be of smaller length, while a >= b means the borrow must end
+    for (auto i = bS; borrow && i < aS; ++i) {
+        borrow = !a.m_limbs[i];
+        a.m_limbs[i] = borrow ? BASE - 1 : a.m_limbs[i] - 1;
+    }
+    a.normalise();
+}
+
+BigInt& operator+=(BigInt& a, const BigInt& b)
+{
+    // both values are below 2^63, so their sum cannot overflow 64 bits
+    if (a.isSmall() && b.isSmall()) {
+        a.assignWord(a.m_small + b.m_small);
+        return a;
+    }
+
+    const BigInt::LimbView bV {b};
+    BigInt::addLimbs(a, bV.data, bV.size);
 
     return a;
 }
-BigInt operator+(const BigInt& a, const BigInt& b)
+BigInt operator+(BigInt a, const BigInt& b)
 {
-    BigInt temp {a};
-    temp += b;
+    a += b;
 
-    return temp;
+    return a;
 }
 BigInt& operator-=(BigInt& a, const BigInt& b)
 {
-    if (a < b) {  // BigInt currently only supports non-negative values
-        throw std::invalid_argument("Attempting to subtract BigInt of greater value");
+    if (a.isSmall() && b.isSmall()) {
+        if (a.m_small < b.m_small)
+            throw std::invalid_argument("Attempting to subtract BigInt of greater value");
+        a.m_small -= b.m_small;
+        return a;
     }
 
-    std::size_t aS = a.length(), bS = b.length();
-    for (int i {0}, carryOver {0}, result; i < aS; ++i) {
-        if (i < bS)
-            result = (a.m_digits[i] - '0') - (b.m_digits[i] - '0') + carryOver;
-        else  // const BigInt may be of smaller length
-            result = (a.m_digits[i] - '0') + carryOver;
-        if (result < 0) {
-            result += 10;
-            carryOver = -1;
+    const BigInt::LimbView bV {b};
+    BigInt::subLimbs(a, bV.data, bV.size);
+
+    return a;
+}
+BigInt operator-(BigInt a, const BigInt& b)
+{
+    a -= b;
+
+    return a;
+}
+
+namespace {
+    /*
+     * Toom-3 evaluation and interpolation steps produce intermediate negative values,
+     * which BigInt does not support, so a sign is tracked separately here.
+     */
+    struct SignedBigInt {
+        BigInt magnitude;
+        bool negative {};
+    };
+
+    SignedBigInt add(const SignedBigInt& x, const SignedBigInt& y)
+    {
+        if (x.negative == y.negative)
+            return {x.magnitude + y.magnitude, x.negative};
+        if (x.magnitude < y.magnitude)
+            return {y.magnitude - x.magnitude, y.negative};
+
+        auto difference = x.magnitude - y.magnitude;
+        bool negative = x.negative && difference != BigInt::zero();
+        return {difference, negative};
+    }
+
+    SignedBigInt subtract(const SignedBigInt& x, const SignedBigInt& y)
+    {
+        return add(x, {y.magnitude, !y.negative && y.magnitude != BigInt::zero()});
+    }
+
+    namespace ntt {
+        /*
+         * Primes of the form c * 2^k + 1 that all have 3 as a primitive root. The
+         * smallest power of 2 among them, 2^23, limits the length of a transform.
+         */
+        constexpr std::uint32_t primes[] {998'244'353, 167'772'161, 469'762'049};
+        constexpr std::uint32_t root {3};
+        constexpr std::size_t maxLength {1 << 23};
+
+        std::uint32_t powMod(std::uint64_t base, std::uint64_t exp, std::uint32_t mod)
+        {
+            std::uint64_t result {1};
+            base %= mod;
+            for (; exp; exp >>= 1) {
+                if (exp & 1)
+                    result = result * base % mod;
+                base = base * base % mod;
+            }
+
+            return result;
         }
-        else {
-            carryOver = 0;
+
+        /*
+         * Iterative in-place Cooley-Tukey transform over the field of integers modulo
+         * MOD, with input size a power of 2. The modulus is a template argument so that
+         * every reduction compiles to a multiplication instead of a division.
+         */
+        template <std::uint32_t MOD>
+        void transform(std::vector<std::uint32_t>& a, bool invert)
+        {
+            const auto n = a.size();
+            for (std::size_t i {1}, j {0}; i < n; ++i) {
+                auto bit = n >> 1;
+                for (; j & bit; bit >>= 1) {
+                    j ^= bit;
+                }
+                j ^= bit;
+                if (i < j)
+                    std::swap(a[i], a[j]);
+            }
+
+            // Shoup's precomputed quotients, floor(w * 2^32 / MOD), replace the modulo
+            // of every butterfly with 2 multiplications and a conditional subtraction
+            std::vector<std::uint32_t> twiddles, quotients;
+            for (std::size_t len {2}; len <= n; len <<= 1) {
+                auto wLen = powMod(root, (MOD - 1) / len, MOD);
+                if (invert)
+                    wLen = powMod(wLen, MOD - 2, MOD);
+                const auto half = len >> 1;
+                twiddles.assign(half, 1);
+                quotients.resize(half);
+                for (std::size_t k {0}; k < half; ++k) {
+                    if (k)
+                        twiddles[k] = 1uLL * twiddles[k-1] * wLen % MOD;
+                    quotients[k] = (std::uint64_t {twiddles[k]} << 32) / MOD;
+                }
+
+                for (std::size_t i {0}; i < n; i += len) {
+                    for (std::size_t k {0}; k < half; ++k) {
+                        const auto u = a[i+k], x = a[i+k+half];
+                        const auto q = static_cast<std::uint32_t>(
+                                1uLL * x * quotients[k] >> 32);
+                        auto v = x * twiddles[k] - q * MOD;
+                        if (v >= MOD)
+                            v -= MOD;
+                        a[i+k] = u + v < MOD ? u + v : u + v - MOD;
+                        a[i+k+half] = u >= v ? u - v : u + MOD - v;
+                    }
+                }
+            }
+
+            if (invert) {
+                const std::uint64_t nInverse = powMod(n, MOD - 2, MOD);
+                for (auto& x : a) {
+                    x = x * nInverse % MOD;
+                }
+            }
+        }
+
+        /*
+         * Stores the cyclic convolution of a and b, modulo MOD, in result, which must
+         * already have a power of 2 size.
+         */
+        template <std::uint32_t MOD, typename Limbs>
+        void convolve(const Limbs& a, const Limbs& b, std::vector<std::uint32_t>& result)
+        {
+            const auto n = result.size();
+            std::fill(result.begin(), result.end(), 0);
+            for (std::size_t i {0}; i < a.size(); ++i) {
+                result[i] = a[i] % MOD;
+            }
+            transform<MOD>(result, false);
+
+            if (&a == &b) {
+                for (auto& x : result) {
+                    x = 1uLL * x * x % MOD;
+                }
+            }
+            else {
+                std::vector<std::uint32_t> other(n, 0);
+                for (std::size_t i {0}; i < b.size(); ++i) {
+                    other[i] = b[i] % MOD;
+                }
+                transform<MOD>(other, false);
+                for (std::size_t i {0}; i < n; ++i) {
+                    result[i] = 1uLL * result[i] * other[i] % MOD;
+                }
+            }
+            transform<MOD>(result, true);
+        }
+    }
+}
+
+/*
+ * @return limbs [from, from + count) of x as a new BigInt, which is zero if the range
+ * starts beyond the most significant limb.
+ */
+BigInt BigInt::slice(const BigInt& x, std::size_t from, std::size_t count)
+{
+    const LimbView xV {x};
+    if (from >= xV.size)
+        return BigInt {};
+
+    const auto to = std::min(xV.size, from + count);
+
+    return BigInt {Limbs(xV.data + from, xV.data + to)};
+}
+
+/*
+ * Adds x * (1e9)^shift to acc in place, without building the shifted value.
+ */
+void BigInt::addShifted(BigInt& acc, const BigInt& x, std::size_t shift)
+{
+    if (x.isZero())
+        return;
+
+    const LimbView xV {x};
+    acc.spill();
+    const auto xS = xV.size;
+    if (acc.m_limbs.size() < xS + shift)
+        acc.m_limbs.resize(xS + shift, 0);
+
+    std::uint32_t carryOver {};
+    for (std::size_t i {0}; i < xS || carryOver; ++i) {
+        if (i + shift == acc.m_limbs.size())
+            acc.m_limbs.push_back(0);
+        auto& limb = acc.m_limbs[i+shift];
+        std::uint32_t sum = limb + carryOver + (i < xS ? xV[i] : 0);
+        carryOver = sum >= BASE;
+        limb = carryOver ? sum - BASE : sum;
+    }
+    acc.normalise();
+}
+
+/*
+ * Divides a by a single word d in one pass from the most significant limb, carrying a
+ * native remainder. Every step divides remainder * 1e9 + limb, which fits in 64 bits
+ * for d < ~1.8e10 and otherwise needs 128 bits where the compiler provides them.
+ *
+ * @param [quotient] may be a itself for in-place division, or nullptr if only the
+ * remainder is required.
+ * @return remainder of the division.
+ */
+unsigned long long BigInt::divideByWord(const BigInt& a, unsigned long long d,
+                                        BigInt* quotient)
+{
+    if (a.isSmall()) {
+        const auto remainder = a.m_small % d;
+        if (quotient != nullptr)
+            quotient->assignWord(a.m_small / d);
+        return remainder;
+    }
+    if (quotient != nullptr && quotient != &a)
+        *quotient = a;
+
+    std::uint64_t remainder {};
+    if (d <= std::numeric_limits<unsigned long long>::max() / BASE) {
+        for (std::size_t i = a.m_limbs.size(); i--;) {
+            auto current = remainder * BASE + a.m_limbs[i];
+            if (quotient != nullptr)
+                quotient->m_limbs[i] = current / d;
+            remainder = current % d;
         }
-        a.m_digits[i] = result + '0';
     }
-    while (aS > 1 && a.m_digits[aS-1] == '0') {
-        a.m_digits.pop_back();
-        aS--;
+    else {
+        // each step divides a 128-bit value, of the remainder & the next limb, by d
+        for (std::size_t i = a.m_limbs.size(); i--;) {
+            std::uint64_t high {};
+            const auto low = uint_detail::mulAdd(remainder, BASE, a.m_limbs[i], 0, high);
+            const auto current = uint_detail::divWide(high, low, d, remainder);
+            if (quotient != nullptr)
+                quotient->m_limbs[i] = static_cast<std::uint32_t>(current);
+        }
     }
+    if (quotient != nullptr)
+        quotient->normalise();
 
-    return a;
+    return remainder;
+}
+
+/*
+ * Chooses a multiplication algorithm based on the limb length of the smaller operand,
+ * as compared to karatsubaThreshold, toom3Threshold and nttThreshold.
+ *
+ * Operands of very different lengths are multiplied in chunks the length of the
+ * smaller operand, as the splitting algorithms are only efficient for balanced sizes.
+ */
+BigInt BigInt::multiply(const BigInt& a, const BigInt& b)
+{
+    const BigInt* small = &a;
+    const BigInt* large = &b;
+    auto sS = LimbView {a}.size, lS = LimbView {b}.size;
+    if (sS > lS) {
+        std::swap(small, large);
+        std::swap(sS, lS);
+    }
+
+    if (sS < karatsubaThreshold)
+        return mulSchoolbook(*large, *small);
+    if (sS >= nttThreshold && sS + lS <= ntt::maxLength)
+        return mulNTT(*large, *small);
+    if (lS >= 2 * sS) {
+        BigInt product;
+        for (std::size_t from {0}; from < lS; from += sS) {
+            addShifted(product, multiply(slice(*large, from, sS), *small), from);
+        }
+        return product;
+    }
+    if (sS < toom3Threshold)
+        return mulKaratsuba(*large, *small);
+
+    return mulToom3(*large, *small);
 }
-BigInt operator-(const BigInt& a, const BigInt& b)
+
+BigInt BigInt::mulSchoolbook(const BigInt& a, const BigInt& b)
 {
-    BigInt temp {a};
-    temp -= b;
+    Limbs product;
+    mulSchoolbook(a, b, product);
 
-    return temp;
+    return BigInt {std::move(product)};
 }
 
-BigInt& operator*=(BigInt& a, const BigInt& b)
+/*
+ * Writes the schoolbook product of a and b into the provided buffer, reusing its
+ * capacity. The buffer must not be the storage of either operand.
+ */
+void BigInt::mulSchoolbook(const BigInt& a, const BigInt& b,
+                           Limbs& cache)
 {
-    auto empty = BigInt::zero();
-    if (a == empty || b == empty) {
-        a = empty;
-        return a;
+    const LimbView aV {a}, bV {b};
+    std::size_t aS = aV.size, bS = bV.size;
+    cache.assign(aS + bS, 0);
+    for (std::size_t i {0}; i < aS; ++i) {
+        std::uint64_t carryOver {};
+        const std::uint64_t limb = aV[i];
+        if (!limb)
+            continue;
+        for (std::size_t j {0}; j < bS; ++j) {
+            // max value is (1e9 - 1)^2 + 2(1e9 - 1), which fits in 64 bits
+            auto result = cache[i+j] + limb * bV[j] + carryOver;
+            cache[i+j] = result % BASE;
+            carryOver = result / BASE;
+        }
+        cache[i+bS] = carryOver;
+    }
+    while (cache.size() > 1 && !cache.back()) {
+        cache.pop_back();
+    }
+}
+
+/*
+ * Splits both operands around k limbs, such that a = a1 * B^k + a0, and replaces the 4
+ * sub-products of the schoolbook method with 3:
+ *
+ *      z0 = a0b0, z2 = a1b1, z1 = (a0 + a1)(b0 + b1) - z0 - z2
+ *
+ *      ab = z2 * B^2k + z1 * B^k + z0
+ */
+BigInt BigInt::mulKaratsuba(const BigInt& a, const BigInt& b)
+{
+    const auto k = (LimbView {a}.size + 1) / 2;
+    const auto a0 = slice(a, 0, k), a1 = slice(a, k, k);
+    const auto b0 = slice(b, 0, k), b1 = slice(b, k, k);
+
+    auto z0 = multiply(a0, b0);
+    auto z2 = multiply(a1, b1);
+    auto z1 = multiply(a0 + a1, b0 + b1);
+    z1 -= z0;
+    z1 -= z2;
+
+    addShifted(z0, z1, k);
+    addShifted(z0, z2, 2 * k);
+
+    return z0;
+}
+
+/*
+ * Splits both operands into 3 parts of k limbs, which are treated as coefficients of a
+ * polynomial evaluated at the points {0, 1, -1, -2, inf}. The 5 pointwise products are
+ * then interpolated back into the coefficients of the product polynomial, using the
+ * sequence described by Bodrato.
+ *
+ * @see https://en.wikipedia.org/wiki/Toom%E2%80%93Cook_multiplication
+ */
+BigInt BigInt::mulToom3(const BigInt& a, const BigInt& b)
+{
+    const auto k = (LimbView {a}.size + 2) / 3;
+
+    auto evaluate = [k](const BigInt& x) {
+        const auto x0 = slice(x, 0, k), x1 = slice(x, k, k), x2 = slice(x, 2 * k, k);
+        const SignedBigInt even {x0 + x2};
+        const auto pM1 = subtract(even, {x1});
+        // p(-2) = 2(p(-1) + x2) - x0
+        const auto half = add(pM1, {x2});
+        const auto pM2 = subtract(add(half, half), {x0});
+        return std::array<SignedBigInt, 5> {
+            SignedBigInt {x0}, add(even, {x1}), pM1, pM2, SignedBigInt {x2}};
+    };
+    const auto pA = evaluate(a), pB = evaluate(b);
+
+    std::array<SignedBigInt, 5> r;
+    for (int i {0}; i < 5; ++i) {
+        r[i] = {multiply(pA[i].magnitude, pB[i].magnitude),
+                pA[i].negative != pB[i].negative};
+        if (r[i].magnitude == BigInt::zero())
+            r[i].negative = false;
+    }
+
+    // r(0), r(1), r(-1), r(-2), r(inf) interpolated to coefficients c0 to c4
+    const auto& c0 = r[0];
+    const auto& c4 = r[4];
+    auto c3 = subtract(r[3], r[1]);
+    divideByWord(c3.magnitude, 3, &c3.magnitude);
+    auto c1 = subtract(r[1], r[2]);
+    divideByWord(c1.magnitude, 2, &c1.magnitude);
+    auto c2 = subtract(r[2], c0);
+    c3 = subtract(c2, c3);
+    divideByWord(c3.magnitude, 2, &c3.magnitude);
+    c3 = add(c3, {c4.magnitude * 2uLL});
+    c2 = subtract(add(c2, c1), c4);
+    c1 = subtract(c1, c3);
+
+    // final coefficients are non-negative, as the operands are
+    BigInt product {c0.magnitude};
+    addShifted(product, c1.magnitude, k);
+    addShifted(product, c2.magnitude, 2 * k);
+    addShifted(product, c3.magnitude, 3 * k);
+    addShifted(product, c4.magnitude, 4 * k);
+
+    return product;
+}
+
+/*
+ * Computes the cyclic convolution of the limbs modulo each of 3 NTT-friendly primes, then
+ * recombines every coefficient using the Chinese Remainder Theorem. A coefficient is at
+ * most n(1e9)^2, which is well below the product of the primes (~7.9e25) for any
+ * supported length.
+ *
+ * Recombination is done in mixed radix, x = r0 + p0 * t1 + p0p1 * t2, with p0p1 split
+ * into 2 limbs, so that every partial sum fits in 64 bits.
+ */
+BigInt BigInt::mulNTT(const BigInt& a, const BigInt& b)
+{
+    const auto aS = a.m_limbs.size(), bS = b.m_limbs.size();
+    // squaring only needs half the forward transforms
+    const auto& bLimbs = a.m_limbs == b.m_limbs ? a.m_limbs : b.m_limbs;
+    std::size_t n {1};
+    while (n < aS + bS) {
+        n <<= 1;
+    }
+
+    std::array<std::vector<std::uint32_t>, 3> residues;
+    for (auto& residue : residues) {
+        residue.resize(n);
+    }
+    ntt::convolve<ntt::primes[0]>(a.m_limbs, bLimbs, residues[0]);
+    ntt::convolve<ntt::primes[1]>(a.m_limbs, bLimbs, residues[1]);
+    ntt::convolve<ntt::primes[2]>(a.m_limbs, bLimbs, residues[2]);
+
+    constexpr std::uint64_t p0 {ntt::primes[0]}, p1 {ntt::primes[1]}, p2 {ntt::primes[2]};
+    constexpr std::uint64_t p01 {p0 * p1};
+    const std::uint64_t inverse0 = ntt::powMod(p0, p1 - 2, p1);
+    const std::uint64_t inverse01 = ntt::powMod(p01, p2 - 2, p2);
+    constexpr std::uint64_t p01Low {p01 % BASE}, p01High {p01 / BASE};
+
+    BigInt product;
+    product.m_limbs.resize(aS + bS);
+    std::uint64_t carryOver {}, pending {};
+    for (std::size_t i {0}; i < aS + bS; ++i) {
+        const std::uint64_t r0 = residues[0][i], r1 = residues[1][i], r2 = residues[2][i];
+        const auto t1 = (r1 + p1 - r0 % p1) % p1 * inverse0 % p1;
+        const auto x01 = r0 + p0 * t1;
+        const auto t2 = (r2 + p2 - x01 % p2) % p2 * inverse01 % p2;
+        // high limb of p0p1 * t2 belongs to the next position
+        const auto current = x01 + t2 * p01Low + pending + carryOver;
+        product.m_limbs[i] = current % BASE;
+        carryOver = current / BASE;
+        pending = t2 * p01High;
+    }
+    product.normalise();
+
+    return product;
+}
+
+/*
+ * Chooses a squaring algorithm with the same thresholds as multiply(). Squaring only
+ * needs 1 recursive operand, so Karatsuba reduces to 3 half-size squares & the NTT to
+ * a single forward transform.
+ */
+BigInt BigInt::square(const BigInt& a)
+{
+    std::uint64_t product;
+    if (a.isSmall() && multiplyWords(a.m_small, a.m_small, product))
+        return BigInt {product};
+
+    const auto size = LimbView {a}.size;
+    if (size < karatsubaThreshold)
+        return sqrSchoolbook(a);
+    if (size >= nttThreshold && 2 * size <= ntt::maxLength)
+        return mulNTT(a, a);
+    if (size >= toom3Threshold)
+        return mulToom3(a, a);
+
+    const auto k = (size + 1) / 2;
+    const auto a0 = slice(a, 0, k), a1 = slice(a, k, k);
+    auto z0 = square(a0);
+    auto z2 = square(a1);
+    auto z1 = square(a0 + a1);
+    z1 -= z0;
+    z1 -= z2;
+
+    addShifted(z0, z1, k);
+    addShifted(z0, z2, 2 * k);
+
+    return z0;
+}
+
+/*
+ * Schoolbook squaring that computes every cross product a_i * a_j, with i < j, only once,
+ * then doubles them while adding the squared limbs on the diagonal, for roughly half
+ * the limb multiplications of mulSchoolbook().
+ */
+BigInt BigInt::sqrSchoolbook(const BigInt& a)
+{
+    const LimbView aV {a};
+    const auto n = aV.size;
+    Limbs cache(2 * n, 0);
+    for (std::size_t i {0}; i < n; ++i) {
+        std::uint64_t carryOver {};
+        const std::uint64_t limb = aV[i];
+        if (!limb)
+            continue;
+        for (std::size_t j = i + 1; j < n; ++j) {
+            auto result = cache[i+j] + limb * aV[j] + carryOver;
+            cache[i+j] = result % BASE;
+            carryOver = result / BASE;
+        }
+        cache[i+n] = carryOver;
+    }
+
+    std::uint64_t carryOver {};
+    for (std::size_t i {0}; i < n; ++i) {
+        const auto diagonal = 1uLL * aV[i] * aV[i];
+        auto current = 2uLL * cache[2*i] + diagonal % BASE + carryOver;
+        cache[2*i] = current % BASE;
+        carryOver = current / BASE;
+        current = 2uLL * cache[2*i+1] + diagonal / BASE + carryOver;
+        cache[2*i+1] = current % BASE;
+        carryOver = current / BASE;
     }
 
-    std::size_t aS = a.length(), bS = b.length();
-    std::vector<int> cache(aS + bS, 0);
-    for (int i {0}; i < aS; ++i) {
-        for (int j {0}; j < bS; ++j) {
-            cache[i+j] += (a.m_digits[i] - '0') * (b.m_digits[j] - '0');
+    return BigInt {std::move(cache)};
+}
+
+/*
+ * Left-to-right binary exponentiation, with every squaring done by square().
+ *
+ * Single-limb bases, e.g. 2^n, instead build a power that is not too large directly, by
+ * multiplying in place by the largest power of the base that fits in a limb. This needs
+ * no squaring & a single growing buffer.
+ */
+BigInt BigInt::pow(unsigned long long exp) const
+{
+    if (!exp)
+        return one();
+    if (exp == 1 || isZero() || *this == one())
+        return *this;
+
+    if (isSmall() && m_small < BASE) {
+        const auto base = static_cast<std::uint32_t>(m_small);
+        std::uint32_t step {base};
+        unsigned long long stepExp {1};
+        while (1uLL * step * base < BASE) {
+            step *= base;
+            stepExp++;
+        }
+        // limbs in the result, with each step adding at most 1
+        if (exp / stepExp < directPowLimit) {
+            BigInt result {one()};
+            for (; exp >= stepExp; exp -= stepExp) {
+                mulWord(result, step);
+            }
+            std::uint32_t rest {1};
+            for (; exp; --exp) {
+                rest *= base;
+            }
+            mulWord(result, rest);
+            return result;
         }
     }
 
-    aS += bS;
-    a.m_digits.resize(cache.size(), '0');
-    for (int i {0}, carryOver {0}, result; i < aS; ++i) {
-        result = carryOver + cache[i];
-        cache[i] = result % 10;
-        carryOver = result / 10;
-        a.m_digits[i] = cache[i] + '0';
+    int bit {63};
+    while (!((exp >> bit) & 1)) {
+        bit--;
     }
+    BigInt result {*this};
+    while (bit--) {
+        result = square(result);
+        if ((exp >> bit) & 1)
+            result *= *this;
+    }
+
+    return result;
+}
 
-    for (auto i = aS - 1; i >= 1 && !cache[i]; --i) {
-        a.m_digits.pop_back();
+/*
+ * Integer Newton's method, x' = ((k - 1)x + n / x^(k - 1)) / k, which decreases
+ * monotonically to the floor of the root as long as it starts from above it.
+ *
+ * The start is 10^(log10(n) / k), based on the leading 2 limbs as a double, so is
+ * accurate to around 15 digits and only a few iterations are needed, each doubling the
+ * correct digits. The estimate is rounded up with a margin, then doubled in the rare
+ * case that it is still below the root.
+ */
+BigInt BigInt::iroot(unsigned long k) const
+{
+    if (!k)
+        throw std::invalid_argument("Root degree must be positive");
+    if (k == 1 || isZero() || *this == one())
+        return *this;
+    // log2(10) < 10 / 3, so 2^k > n for all larger k
+    if (k > length() * 10 / 3 + 1)
+        return one();
+
+    const LimbView limbs {*this};
+    double leading = limbs.back();
+    if (limbs.size > 1)
+        leading = leading * BASE + limbs[limbs.size-2];
+    const auto log10 = std::log10(leading) +
+            BASE_DIGITS * static_cast<double>(limbs.size - std::min(limbs.size, std::size_t {2}));
+    const auto rootLog = log10 / static_cast<double>(k);
+    const auto scale = rootLog > 17 ? static_cast<unsigned long long>(rootLog) - 17 : 0;
+    const auto leadingRoot = std::pow(10.0, rootLog - static_cast<double>(scale));
+    BigInt x {static_cast<unsigned long long>(leadingRoot * (1 + 1e-12)) + 1};
+    if (scale)
+        x *= ten().pow(scale);
+    while (x.pow(k) <= *this) {
+        x *= 2uLL;
+    }
+
+    while (true) {
+        auto next = x * (k - 1) + *this / x.pow(k - 1);
+        next /= k;
+        if (next >= x)
+            return x;
+        x = std::move(next);
     }
+}
 
-    return a;
+/*
+ * Takes prime roots of the remaining base for as long as they are exact, so that the
+ * product of those primes is the largest possible exponent. A prime p only needs to be
+ * tried while 2^p does not exceed the remaining base.
+ */
+bool BigInt::isPerfectPower(BigInt* base, unsigned long* exponent) const
+{
+    BigInt root {*this};
+    unsigned long power {1};
+    for (unsigned long p {2}; p <= root.length() * 10 / 3 + 1; ++p) {
+        bool prime {true};
+        for (unsigned long d {2}; d * d <= p && prime; ++d) {
+            prime = p % d;
+        }
+        if (!prime)
+            continue;
+
+        while (root > one()) {
+            auto candidate = root.iroot(p);
+            if (candidate.pow(p) != root)
+                break;
+            root = std::move(candidate);
+            power *= p;
+        }
+    }
+
+    if (power == 1 || root <= one())
+        return false;
+    if (base != nullptr)
+        *base = root;
+    if (exponent != nullptr)
+        *exponent = power;
+
+    return true;
 }
-BigInt operator*(const BigInt& a, const BigInt& b)
+
+namespace {
+    // subtrees with fewer leaves than this are not worth a thread of their own
+    constexpr std::size_t parallelGrain {64};
+    // leaves summed in place, one after another, as addition gains nothing from balance
+    constexpr std::size_t sumChunk {256};
+}
+
+unsigned BigInt::threadBudget()
 {
-    BigInt temp {a};
-    temp *= b;
+    if (reductionThreads)
+        return reductionThreads;
 
-    return temp;
+    return std::max(1u, std::thread::hardware_concurrency());
 }
-BigInt& operator/=(BigInt& a, const BigInt& b)
+
+/*
+ * Combines values [from, to), which are moved from, by splitting the range in half and
+ * recursing. While more than 1 thread remains in the budget, the left half is evaluated
+ * asynchronously and the budget is shared between both halves.
+ */
+BigInt BigInt::reduceTree(std::vector<BigInt>& values, std::size_t from, std::size_t to,
+                          unsigned threads, bool multiply)
 {
-    const auto zero = BigInt::zero();
-    if (b == zero) {
-        throw std::runtime_error("Division by zero");
+    const auto count = to - from;
+    if (!count)
+        return multiply ? one() : zero();
+    if (count == 1)
+        return std::move(values[from]);
+    if (!multiply && count <= sumChunk) {
+        auto sum = std::move(values[from]);
+        for (auto i = from + 1; i < to; ++i) {
+            sum += values[i];
+        }
+        return sum;
     }
-    if (a < b) {
-        a = zero;
+
+    const auto middle = from + count / 2;
+    BigInt left, right;
+    if (threads > 1 && count >= parallelGrain) {
+        auto pending = std::async(std::launch::async, reduceTree, std::ref(values), from,
+                                  middle, threads / 2, multiply);
+        right = reduceTree(values, middle, to, threads - threads / 2, multiply);
+        left = pending.get();
+    }
+    else {
+        left = reduceTree(values, from, middle, 1, multiply);
+        right = reduceTree(values, middle, to, 1, multiply);
+    }
+
+    return multiply ? left * right : std::move(left += right);
+}
+
+/*
+ * Multiplies in place where possible. A single-limb right operand is applied directly to
+ * the limbs of a, while other schoolbook-sized products are written to a scratch buffer
+ * that is then swapped with the limbs of a. As the swapped out buffer becomes the next
+ * scratch buffer, repeated calls stop allocating once both buffers are large enough.
+ * Limbs from an arena are not swapped, as the scratch buffer lives on the heap.
+ */
+BigInt& operator*=(BigInt& a, const BigInt& b)
+{
+    if (a.isZero() || b.isZero()) {
+        a.assignWord(0);
         return a;
     }
-    if (a == b) {
-        a = BigInt::one();
+    std::uint64_t product;
+    if (a.isSmall() && b.isSmall() && BigInt::multiplyWords(a.m_small, b.m_small, product)) {
+        a.assignWord(product);
         return a;
     }
 
-    std::size_t aS = a.length(), bS = b.length();
-    BigInt carryOver = zero;
-    const auto ten = BigInt::ten();
-    int i;
-    for (i = aS - 1; ; --i) {
-        auto ch = BigInt {static_cast<unsigned long long>(a.m_digits[i] - '0')};
-        if (carryOver * ten + ch >= b)
-            break;
-        carryOver *= ten;
-        carryOver += ch;
+    const auto aS = BigInt::LimbView {a}.size, bS = BigInt::LimbView {b}.size;
+    if (bS == 1) {
+        BigInt::mulWord(a, BigInt::LimbView {b}[0]);
+        return a;
+    }
+    if (&a == &b) {
+        a = BigInt::square(a);
+        return a;
+    }
+    // always on the heap, as it outlives any arena scope
+    thread_local BigInt::Limbs scratch {BigInt::Limbs::allocator_type {nullptr}};
+    if (std::min(aS, bS) < BigInt::karatsubaThreshold &&
+        a.m_limbs.get_allocator() == scratch.get_allocator()) {
+        if (scratch.capacity() < aS + bS)
+            scratch.reserve(std::max(aS + bS, 2 * scratch.capacity()));
+        BigInt::mulSchoolbook(a, b, scratch);
+        a.m_limbs.swap(scratch);
+        a.normalise();
+        return a;
     }
 
-    std::vector<unsigned long> cache(aS, 0);
-    unsigned long long cc {}, lgcat {};
-    for (; i >= 0; --i) {
-        auto ch = BigInt {static_cast<unsigned long long>(a.m_digits[i] - '0')};
-        carryOver = carryOver * ten + ch;
-        for (cc = 9uLL; BigInt {cc} * b > carryOver; --cc);
-        carryOver -= BigInt {cc} * b;
-        cache[lgcat++] = cc;
+    a = BigInt::multiply(a, b);
+
+    return a;
+}
+BigInt operator*(const BigInt& a, const BigInt& b)
+{
+    if (a.isZero() || b.isZero())
+        return BigInt {};
+    std::uint64_t product;
+    if (a.isSmall() && b.isSmall() && BigInt::multiplyWords(a.m_small, b.m_small, product))
+        return BigInt {product};
+    if (&a == &b)
+        return BigInt::square(a);
+
+    return BigInt::multiply(a, b);
+}
+
+/*
+ * Replaces a in place with a * m + w, in a single pass over its limbs. As both m and w
+ * are below BASE, every step fits in 64 bits and the final carry is a single limb.
+ */
+void BigInt::mulAddWord(BigInt& a, std::uint32_t m, std::uint32_t w)
+{
+    a.spill();
+    std::uint64_t carryOver {w};
+    for (auto& limb : a.m_limbs) {
+        auto current = 1uLL * limb * m + carryOver;
+        limb = current % BASE;
+        carryOver = current / BASE;
+    }
+    if (carryOver)
+        a.m_limbs.push_back(carryOver);
+    a.normalise();
+}
+
+/*
+ * Adds w to a in place, stopping as soon as no carry is left, so that adding a word to
+ * a large value only touches its lowest limbs.
+ */
+void BigInt::addWord(BigInt& a, std::uint64_t w)
+{
+    a.spill();
+    for (std::size_t i {0}; w; ++i) {
+        if (i == a.m_limbs.size())
+            a.m_limbs.push_back(0);
+        const std::uint64_t current = a.m_limbs[i] + w % BASE;
+        a.m_limbs[i] = current % BASE;
+        w = w / BASE + current / BASE;
+    }
+    a.normalise();
+}
+
+BigInt& operator*=(BigInt& a, unsigned long long m)
+{
+    std::uint64_t product;
+    if (a.isSmall() && BigInt::multiplyWords(a.m_small, m, product)) {
+        a.assignWord(product);
+        return a;
     }
+    if (m >= BigInt::BASE)
+        return a *= BigInt {m};
+
+    BigInt::mulWord(a, m);
+    return a;
+}
+BigInt operator*(BigInt a, unsigned long long m)
+{
+    a *= m;
 
-    a.m_digits.resize(cache.size(), '0');
-    for (i = 0; i < lgcat; ++i) {
-        a.m_digits[i] = cache[lgcat-i-1] + '0';
+    return a;
+}
+
+BigInt& operator+=(BigInt& a, unsigned long long w)
+{
+    // a is below 2^63, so the sum cannot overflow 64 bits
+    if (a.isSmall() && w < BigInt::SMALL_LIMIT) {
+        a.assignWord(a.m_small + w);
+        return a;
     }
-    a.m_digits.resize(lgcat);
 
+    BigInt::addWord(a, w);
     return a;
 }
-BigInt operator/(const BigInt& a, const BigInt& b)
+BigInt operator+(BigInt a, unsigned long long w)
+{
+    a += w;
+
+    return a;
+}
+
+/*
+ * Long division based on Knuth's Algorithm D (TAOCP Vol. 2, 4.3.1), using limbs as
+ * digits in base 1e9.
+ *
+ * Both operands are first normalised by a factor that makes the leading limb of the
+ * divisor at least 1e9 / 2, which guarantees that every quotient limb estimated from
+ * the leading 2 limbs of the remainder & the leading limb of the divisor is at most 2
+ * too large. The estimate is corrected against the next limb of the divisor, then a
+ * single multiply & subtract pass is made per quotient limb, with a rare add back step
+ * if the estimate was still too large by 1.
+ *
+ * @return pair of {quotient, remainder}.
+ * @throws std::runtime_error if b = 0.
+ */
+std::pair<BigInt, BigInt> divmod(const BigInt& a, const BigInt& b)
+{
+    if (b.isZero()) {
+        throw std::runtime_error("Division by zero");
+    }
+    if (a < b) {
+        return {BigInt::zero(), a};
+    }
+    if (b.isSmall()) {
+        auto [quotient, remainder] = divmod(a, b.m_small);
+        return {quotient, BigInt {remainder}};
+    }
+
+    // both operands are now at least 2^63, so stored as at least 3 limbs
+    constexpr auto base = BigInt::BASE;
+    const auto factor = static_cast<std::uint32_t>(base / (b.m_limbs.back() + 1uLL));
+    BigInt u {a}, v {b};
+    BigInt::mulWord(u, factor);
+    BigInt::mulWord(v, factor);
+    const auto n = v.m_limbs.size();
+    const auto m = a.m_limbs.size() - b.m_limbs.size();
+    u.m_limbs.resize(m + n + 1, 0);
+    const std::uint64_t vTop = v.m_limbs[n-1], vNext = v.m_limbs[n-2];
+
+    BigInt quotient;
+    quotient.m_limbs.assign(m + 1, 0);
+    for (std::size_t j = m + 1; j--;) {
+        const auto numerator = u.m_limbs[j+n] * 1uLL * base + u.m_limbs[j+n-1];
+        std::uint64_t qHat = numerator / vTop, rHat = numerator % vTop;
+        while (qHat >= base || qHat * vNext > rHat * base + u.m_limbs[j+n-2]) {
+            qHat--;
+            rHat += vTop;
+            if (rHat >= base)
+                break;
+        }
+
+        // u[j..j+n] -= qHat * v
+        std::uint64_t carryOver {};
+        std::int64_t borrow {};
+        for (std::size_t i {0}; i < n; ++i) {
+            auto product = qHat * v.m_limbs[i] + carryOver;
+            carryOver = product / base;
+            std::int64_t t = u.m_limbs[i+j] - static_cast<std::int64_t>(product % base) -
+                    borrow;
+            borrow = t < 0;
+            u.m_limbs[i+j] = t < 0 ? t + base : t;
+        }
+        std::int64_t top = u.m_limbs[j+n] - static_cast<std::int64_t>(carryOver) - borrow;
+
+        if (top < 0) {
+            // qHat was 1 too large, so v is added back, with the carry cancelling top
+            qHat--;
+            std::uint32_t carry {};
+            for (std::size_t i {0}; i < n; ++i) {
+                std::uint32_t sum = u.m_limbs[i+j] + v.m_limbs[i] + carry;
+                carry = sum >= base;
+                u.m_limbs[i+j] = carry ? sum - base : sum;
+            }
+            top += carry;
+        }
+        u.m_limbs[j+n] = top;
+        quotient.m_limbs[j] = qHat;
+    }
+
+    quotient.normalise();
+    u.m_limbs.resize(n);
+    u.trim();
+    BigInt::divideByWord(u, factor, &u);
+
+    return {quotient, u};
+}
+
+BigInt& operator/=(BigInt& a, const BigInt& b)
 {
-    BigInt temp {a};
-    temp /= b;
+    a = divmod(a, b).first;
 
-    return temp;
+    return a;
+}
+BigInt operator/(const BigInt& a, const BigInt& b)
+{
+    return divmod(a, b).first;
 }
 BigInt& operator%=(BigInt& a, const BigInt& b)
 {
-    const auto zero = BigInt::zero();
-    if (b == zero) {
+    a = divmod(a, b).second;
+
+    return a;
+}
+BigInt operator%(const BigInt& a, const BigInt& b)
+{
+    return divmod(a, b).second;
+}
+
+/*
+ * @return pair of {quotient, remainder}, with the latter as a native value.
+ * @throws std::runtime_error if d = 0.
+ */
+std::pair<BigInt, unsigned long long> divmod(const BigInt& a, unsigned long long d)
+{
+    if (!d) {
         throw std::runtime_error("Division by zero");
     }
-    const auto one = BigInt::one();
-    if (a == b || b == one) {
-        a = zero;
-        return a;
+
+    BigInt quotient;
+    auto remainder = BigInt::divideByWord(a, d, &quotient);
+
+    return {quotient, remainder};
+}
+
+BigInt& operator/=(BigInt& a, unsigned long long d)
+{
+    if (!d) {
+        throw std::runtime_error("Division by zero");
     }
-    if (a < b) {
-        return a;
+    BigInt::divideByWord(a, d, &a);
+
+    return a;
+}
+BigInt operator/(const BigInt& a, unsigned long long d)
+{
+    return divmod(a, d).first;
+}
+BigInt& operator%=(BigInt& a, unsigned long long d)
+{
+    a.assignWord(a % d);
+
+    return a;
+}
+/*
+ * Reads the limbs of a once without building a quotient.
+ */
+unsigned long long operator%(const BigInt& a, unsigned long long d)
+{
+    if (!d) {
+        throw std::runtime_error("Division by zero");
     }
 
-    std::size_t aS = a.length(), bS = b.length();
-    BigInt carryOver = zero;
-    const auto ten = BigInt::ten();
-    int i;
-    for (i = aS - 1; ; --i) {
-        auto ch = BigInt {static_cast<unsigned long long>(a.m_digits[i] - '0')};
-        if (carryOver * ten + ch >= b)
+    return BigInt::divideByWord(a, d, nullptr);
+}
+
+namespace {
+    /*
+     * Stein's binary algorithm, which replaces divisions with shifts & subtractions, for
+     * when both values fit in a machine word.
+     */
+    std::uint64_t binaryGcd(std::uint64_t a, std::uint64_t b)
+    {
+        if (!a || !b)
+            return a | b;
+
+        auto trailingZeros = [](std::uint64_t x) {
+#if defined(__GNUC__)
+            return __builtin_ctzll(x);
+#else
+            int count {};
+            for (; !(x & 1); x >>= 1) {
+                count++;
+            }
+            return count;
+#endif
+        };
+        const auto shift = trailingZeros(a | b);
+        a >>= trailingZeros(a);
+        do {
+            b >>= trailingZeros(b);
+            if (a > b)
+                std::swap(a, b);
+            b -= a;
+        } while (b);
+
+        return a << shift;
+    }
+}
+
+/*
+ * Knuth's Algorithm L, which runs Euclid's algorithm on the leading 2 limbs of u & v,
+ * at the same position, for as long as the quotients are guaranteed to match those of
+ * the full values. The steps are accumulated in the cofactors {A, B, C, D}, so that the
+ * remainders they lead to are A * u + B * v & C * u + D * v.
+ *
+ * Cofactors are kept at most BASE, so that combine() stays within 64 bits.
+ *
+ * @return the amount of steps taken, which is 0 if the leading limbs are not enough to
+ * predict even 1 quotient.
+ */
+unsigned BigInt::lehmerCofactors(const BigInt& u, const BigInt& v,
+                                 std::int64_t (&cofactors)[4])
+{
+    const auto n = u.m_limbs.size();
+    const auto& vLimbs = v.m_limbs;
+    if (vLimbs.size() + 1 < n)
+        return 0;
+
+    std::int64_t x = 1LL * u.m_limbs[n-1] * BASE + u.m_limbs[n-2];
+    std::int64_t y = (vLimbs.size() == n ? 1LL * vLimbs[n-1] * BASE : 0) + vLimbs[n-2];
+    std::int64_t a {1}, b {0}, c {0}, d {1};
+    unsigned steps {};
+    while (y + c > 0 && y + d > 0) {
+        const auto q = (x + a) / (y + c);
+        if (q != (x + b) / (y + d) || q > BASE)
             break;
-        carryOver *= ten;
-        carryOver += ch;
+        const auto nextC = a - q * c, nextD = b - q * d;
+        if (std::abs(nextC) > BASE || std::abs(nextD) > BASE)
+            break;
+
+        a = c;
+        b = d;
+        c = nextC;
+        d = nextD;
+        const auto nextY = x - q * y;
+        x = y;
+        y = nextY;
+        steps++;
     }
 
-    std::vector<unsigned long> cache(aS, 0);
-    unsigned long long cc, lgcat {};
-    for (; i >= 0; --i) {
-        auto ch = BigInt {static_cast<unsigned long long>(a.m_digits[i] - '0')};
-        carryOver = carryOver * ten + ch;
-        for (cc = 9uLL; BigInt {cc} * b > carryOver; --cc);
-        carryOver -= BigInt {cc} * b;
-        cache[lgcat++] = cc;
+    cofactors[0] = a;
+    cofactors[1] = b;
+    cofactors[2] = c;
+    cofactors[3] = d;
+
+    return steps;
+}
+
+BigInt BigInt::combine(const BigInt& u, const BigInt& v, std::int64_t x, std::int64_t y)
+{
+    const LimbView uLimbs {u}, vLimbs {v};
+    Limbs result(uLimbs.size);
+    std::int64_t carryOver {};
+    for (std::size_t i {0}; i < uLimbs.size; ++i) {
+        auto current = x * uLimbs[i] + carryOver;
+        if (i < vLimbs.size)
+            current += y * vLimbs[i];
+        // floored division, so that every limb is non-negative
+        carryOver = current / static_cast<std::int64_t>(BASE);
+        current %= static_cast<std::int64_t>(BASE);
+        if (current < 0) {
+            current += BASE;
+            carryOver--;
+        }
+        result[i] = current;
     }
 
-    a = carryOver;
-    return a;
+    return BigInt {std::move(result)};
 }
-BigInt operator%(const BigInt& a, const BigInt& b)
+
+/*
+ * Lehmer's algorithm, which replaces most multi-limb divisions of Euclid's algorithm
+ * with 2 linear passes that each reduce the values by around 1 limb. A full division is
+ * only taken when the leading limbs cannot predict a quotient, which is usually when it
+ * is large. Once the smaller value fits in a machine word, a single word modulo & binary
+ * GCD finish it off.
+ */
+BigInt gcd(const BigInt& a, const BigInt& b)
 {
-    BigInt temp {a};
-    temp %= b;
+    if (a.isSmall() && b.isSmall())
+        return BigInt {binaryGcd(a.m_small, b.m_small)};
+
+    const auto aIsLarger = a >= b;
+    BigInt u {aIsLarger ? a : b}, v {aIsLarger ? b : a};
+    while (!v.isSmall()) {
+        std::int64_t cofactors[4];
+        if (BigInt::lehmerCofactors(u, v, cofactors)) {
+            auto next = BigInt::combine(u, v, cofactors[2], cofactors[3]);
+            u = BigInt::combine(u, v, cofactors[0], cofactors[1]);
+            v = std::move(next);
+        }
+        else {
+            u %= v;
+            std::swap(u, v);
+        }
+    }
 
-    return temp;
+    if (v.isZero())
+        return u;
+    return BigInt {binaryGcd(v.m_small, u % v.m_small)};
+}
+
+BigInt lcm(const BigInt& a, const BigInt& b)
+{
+    if (a.isZero() || b.isZero())
+        return BigInt::zero();
+
+    return a / gcd(a, b) * b;
+}
+
+/*
+ * Follows the same steps as gcd(), while also tracking the cofactor s of a for each
+ * remainder r, such that a * s = r (mod b).
+ *
+ * The cofactors of consecutive remainders alternate in sign, so only their magnitudes
+ * are stored, along with the parity of the current step. This also means that
+ * cofactors never need to be subtracted, e.g. s_next = s_prev - q * s has magnitude
+ * |s_prev| + q * |s|.
+ */
+std::pair<BigInt, BigInt> extendedGcd(const BigInt& a, const BigInt& b)
+{
+    auto magnitude = [](std::int64_t c) { return static_cast<unsigned long long>(std::abs(c)); };
+    BigInt u {a}, v {b}, uCofactor {1uLL}, vCofactor;
+    bool uNegative {false};
+    while (!v.isZero()) {
+        std::int64_t m[4];
+        const auto steps = !v.isSmall() && u >= v ? BigInt::lehmerCofactors(u, v, m) : 0;
+        if (steps) {
+            auto next = BigInt::combine(u, v, m[2], m[3]);
+            u = BigInt::combine(u, v, m[0], m[1]);
+            v = std::move(next);
+            auto nextCofactor = uCofactor * magnitude(m[2]) + vCofactor * magnitude(m[3]);
+            uCofactor = uCofactor * magnitude(m[0]) + vCofactor * magnitude(m[1]);
+            vCofactor = std::move(nextCofactor);
+            uNegative ^= steps & 1;
+        }
+        else {
+            auto [quotient, remainder] = divmod(u, v);
+            u = std::move(v);
+            v = std::move(remainder);
+            uCofactor += quotient * vCofactor;
+            std::swap(uCofactor, vCofactor);
+            uNegative = !uNegative;
+        }
+    }
+
+    if (b.isZero())
+        return {u, BigInt::one()};
+
+    const auto modulus = b / u;
+    auto x = uCofactor % modulus;
+    if (uNegative && !x.isZero())
+        x = modulus - x;
+
+    return {u, x};
 }
 
 TEST_SUITE("test BigInt") {
@@ -327,6 +1933,45 @@ TEST_SUITE("test BigInt") {
         CHECK_EQ(expectedLL, zero.toULLong());
     }
 
+    TEST_CASE("move constructor and assignment") {
+        static_assert(std::is_nothrow_move_constructible_v<BigInt>);
+
+        BigInt a {"123456789123456789123456789"};
+        BigInt b {std::move(a)};
+        BigInt c;
+        const auto allocations = countAllocations([&b, &c] { c = std::move(b); });
+
+        CHECK_EQ("123456789123456789123456789", c.toString());
+        CHECK_EQ(0, allocations);
+        CHECK_EQ(&BigInt::one(), &BigInt::one());
+    }
+
+    TEST_CASE("move assignment between values bound to different arenas") {
+        Arena first, second;
+        BigInt onHeap {"123456789123456789123456789"};
+        {
+            const ArenaScope scope {&first};
+            BigInt inFirst {"987654321987654321987654321"};
+            BigInt small {42uLL};
+            {
+                const ArenaScope inner {&second};
+                BigInt inSecond {"111111111111111111111111111"};
+                inSecond = std::move(inFirst);
+                CHECK_EQ(BigInt {"987654321987654321987654321"}, inSecond);
+                inSecond = std::move(small);
+                CHECK_EQ(BigInt {42uLL}, inSecond);
+            }
+            // copied into the storage of the heap value, which outlives the arenas
+            onHeap = BigInt {"555555555555555555555555555"};
+        }
+        {
+            const ArenaScope scope {&first};
+            BigInt other {"999999999999999999999999999999999999999999999"};
+        }
+
+        CHECK_EQ(BigInt {"555555555555555555555555555"}, onHeap);
+    }
+
     TEST_CASE("equality comparison") {
         std::string number {"1234567890"};
         unsigned long long num {1'234'567'890};
@@ -364,6 +2009,58 @@ TEST_SUITE("test BigInt") {
         CHECK_GE(d, b);
     }
 
+    TEST_CASE("fingerprint() and std::hash") {
+        const BigInt a {"123456789012345678901234567890"};
+        BigInt b {"123456789012345678901234567891"};
+        const std::hash<BigInt> hasher;
+
+        CHECK_EQ(a.fingerprint(), BigInt {a}.fingerprint());
+        CHECK_EQ(hasher(a), hasher(BigInt {a.toString()}));
+        CHECK_EQ(hasher(BigInt {42uLL}), hasher(BigInt {"42"}));
+        CHECK_NE(a.fingerprint(), b.fingerprint());
+        CHECK_NE(a, b);
+
+        // the cached fingerprint follows every change of value
+        --b;
+        CHECK_EQ(a.fingerprint(), b.fingerprint());
+        CHECK_EQ(a, b);
+        ++b;
+        b += BigInt {"999999999999999999999"};
+        b -= BigInt {"1000000000000000000000"};
+        CHECK_EQ(a.fingerprint(), b.fingerprint());
+        b *= 10uLL;
+        b /= 10uLL;
+        CHECK_EQ(a.fingerprint(), b.fingerprint());
+
+        std::unordered_set<std::uint64_t> fingerprints;
+        BigInt power {BigInt::one()};
+        for (int i {0}; i < 10'000; ++i) {
+            power *= 3uLL;
+            fingerprints.insert(power.fingerprint());
+        }
+        CHECK_EQ(10'000, fingerprints.size());
+    }
+
+    TEST_CASE("fingerprint() of a value shared between threads") {
+        const BigInt shared {BigInt {"123456789012345678901234567890"}.pow(10uLL)};
+        const BigInt copy {shared.toString()};
+        std::vector<std::thread> threads;
+        std::vector<int> matches(4);
+        for (std::size_t i {0}; i < matches.size(); ++i) {
+            threads.emplace_back([&shared, &copy, &matches, i] {
+                for (int j {0}; j < 1000; ++j) {
+                    matches[i] += shared == copy &&
+                            std::hash<BigInt> {}(shared) == copy.fingerprint();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        CHECK_EQ(std::vector<int>(4, 1000), matches);
+    }
+
     TEST_CASE("increment operators") {
         std::string number {"9999999"};
         BigInt a {number};
@@ -495,6 +2192,124 @@ TEST_SUITE("test BigInt") {
         CHECK_EQ(expected, a.toString());
     }
 
+    TEST_CASE("multiplication above thresholds") {
+        // (10^k - 1)^2 = 10^2k - 2 * 10^k + 1 = 9..980..01
+        const std::size_t k {5000};
+        const BigInt a {std::string(k, '9')};
+        const std::string expected = std::string(k - 1, '9') + "8" +
+                std::string(k - 1, '0') + "1";
+
+        CHECK_LE(BigInt::toom3Threshold * 9, k);
+        CHECK_EQ(expected, (a * a).toString());
+    }
+
+    TEST_CASE("multiplication algorithms agree") {
+        const auto karatsuba = BigInt::karatsubaThreshold;
+        const auto toom3 = BigInt::toom3Threshold;
+        const auto ntt = BigInt::nttThreshold;
+        std::mt19937 generator {26};
+        std::uniform_int_distribution<int> digit {0, 9};
+        auto randomBigInt = [&](std::size_t digits) {
+            std::string number(digits, '0');
+            for (auto& ch : number) {
+                ch = static_cast<char>('0' + digit(generator));
+            }
+            return BigInt {number};
+        };
+
+        std::size_t sizes[][2] {{100, 100}, {250, 900}, {1000, 999}, {5000, 101},
+                                {3000, 4000}};
+        for (const auto& [aS, bS] : sizes) {
+            const auto a = randomBigInt(aS), b = randomBigInt(bS);
+            BigInt::karatsubaThreshold = BigInt::toom3Threshold = SIZE_MAX;
+            BigInt::nttThreshold = SIZE_MAX;
+            const auto expected = a * b;
+
+            BigInt::karatsubaThreshold = 2;
+            CHECK_EQ(expected, a * b);
+            BigInt::toom3Threshold = 3;
+            CHECK_EQ(expected, a * b);
+            CHECK_EQ(expected, b * a);
+            BigInt::nttThreshold = 4;
+            CHECK_EQ(expected, a * b);
+            CHECK_EQ(expected * expected, expected * expected);
+            BigInt::karatsubaThreshold = karatsuba;
+            BigInt::toom3Threshold = toom3;
+            BigInt::nttThreshold = ntt;
+        }
+    }
+
+    TEST_CASE("multiplication with NTT for very large operands") {
+        // 2^100'000 has 30'103 digits
+        const auto power = BigInt {2uLL}.pow(BigInt {100'000uLL});
+        const auto digits = power.toString();
+        unsigned long digitSum {};
+        for (const auto& ch : digits) {
+            digitSum += ch - '0';
+        }
+
+        CHECK_EQ(30'103, power.length());
+        CHECK_EQ("99900209301438450794", digits.substr(0, 20));
+        CHECK_EQ(135'178, digitSum);
+        CHECK_EQ(power, BigInt {2uLL}.pow(BigInt {50'000uLL}).pow(BigInt {2uLL}));
+    }
+
+    /*
+     * Benchmark used to choose default thresholds, run with --no-skip. For every size,
+     * one level of each faster algorithm is timed against the slower ones, with any
+     * recursive sub-products using the default thresholds.
+     */
+    TEST_CASE("multiplication crossover benchmark" * doctest::skip()) {
+        const auto karatsuba = BigInt::karatsubaThreshold;
+        const auto toom3 = BigInt::toom3Threshold;
+        const auto ntt = BigInt::nttThreshold;
+        std::mt19937 generator {26};
+        std::uniform_int_distribution<int> digit {0, 9};
+        // best of 5 rounds, to reduce noise from other processes
+        auto time = [](const BigInt& a, const BigInt& b, int repeat) {
+            double best {std::numeric_limits<double>::max()};
+            for (int round {0}; round < 5; ++round) {
+                const auto start = std::chrono::steady_clock::now();
+                for (int r {0}; r < repeat; ++r) {
+                    auto product = a * b;
+                }
+                const std::chrono::duration<double, std::micro> elapsed {
+                    std::chrono::steady_clock::now() - start};
+                best = std::min(best, elapsed.count() / repeat);
+            }
+            return best;
+        };
+
+        for (std::size_t limbs : {16, 24, 32, 48, 64, 96, 128, 160, 192, 256, 384, 512,
+                                  768, 1024, 1536, 2048, 4096}) {
+            std::string number(limbs * 9, '0');
+            for (auto& ch : number) {
+                ch = static_cast<char>('1' + digit(generator) % 9);
+            }
+            const BigInt a {number};
+            std::reverse(number.begin(), number.end());
+            const BigInt b {number};
+            const int repeat = std::max(3, static_cast<int>(4'000'000 / (limbs * limbs)));
+
+            BigInt::karatsubaThreshold = BigInt::toom3Threshold = SIZE_MAX;
+            BigInt::nttThreshold = SIZE_MAX;
+            const auto schoolbook = time(a, b, repeat);
+            BigInt::karatsubaThreshold = std::min(karatsuba, limbs);
+            const auto splitOnce = time(a, b, repeat);
+            BigInt::toom3Threshold = std::min(toom3, limbs);
+            const auto toomOnce = time(a, b, repeat);
+            BigInt::nttThreshold = limbs;
+            const auto transform = time(a, b, repeat);
+            BigInt::karatsubaThreshold = karatsuba;
+            BigInt::toom3Threshold = toom3;
+            BigInt::nttThreshold = ntt;
+
+            MESSAGE(limbs << " limbs: schoolbook " << schoolbook << "us, karatsuba " <<
+                    splitOnce << "us, toom-3 " << toomOnce << "us, ntt " << transform <<
+                    "us");
+        }
+    }
+
     TEST_CASE("division when b = 0") {
         const BigInt a {"123456"};
         const BigInt b {BigInt::zero()};
@@ -582,6 +2397,329 @@ TEST_SUITE("test BigInt") {
         CHECK_EQ(expected, a.toString());
     }
 
+    TEST_CASE("constructors with leading zeros") {
+        const BigInt a {"0000000000000012345"};
+        const BigInt b {"000"};
+
+        CHECK_EQ(BigInt {12345uLL}, a);
+        CHECK_EQ("12345", a.toString());
+        CHECK_EQ(BigInt::zero(), b);
+        CHECK_EQ("0", b.toString());
+    }
+
+    TEST_CASE("constructors with invalid string") {
+        CHECK_THROWS_AS(BigInt {"12a45"}, std::invalid_argument);
+        CHECK_THROWS_AS(BigInt {""}, std::invalid_argument);
+    }
+
+    TEST_CASE("length() across limbs") {
+        const BigInt a {"1"};
+        const BigInt b {"999999999"};
+        const BigInt c {"1000000000"};
+        const BigInt d {"123456789012345678901234567890"};
+
+        CHECK_EQ(1, a.length());
+        CHECK_EQ(9, b.length());
+        CHECK_EQ(10, c.length());
+        CHECK_EQ(30, d.length());
+    }
+
+    TEST_CASE("digitSum()") {
+        CHECK_EQ(0, BigInt::zero().digitSum());
+        CHECK_EQ(45, BigInt {1'234'567'890uLL}.digitSum());
+        CHECK_EQ(9 * 40, BigInt {std::string(40, '9')}.digitSum());
+        CHECK_EQ(1, BigInt {"1" + std::string(30, '0')}.digitSum());
+        CHECK_EQ(1366, BigInt {2uLL}.pow(BigInt {1000uLL}).digitSum());
+    }
+
+    TEST_CASE("leadingDigits()") {
+        const std::string number {"12345678901234567890123456789012345678"};
+        const BigInt a {number};
+
+        for (std::size_t k : {0, 1, 2, 9, 10, 11, 18, 19, 20, 37}) {
+            CHECK_EQ(number.substr(0, k), a.leadingDigits(k));
+        }
+        CHECK_EQ(number, a.leadingDigits(38));
+        CHECK_EQ(number, a.leadingDigits(100));
+        CHECK_EQ("1000000000", BigInt {"1" + std::string(30, '0')}.leadingDigits(10));
+        CHECK_EQ("123", BigInt {123'456uLL}.leadingDigits(3));
+    }
+
+    TEST_CASE("toString() pads inner limbs") {
+        const std::string number {"1000000000000000001000000001"};
+        const BigInt a {number};
+
+        CHECK_EQ(number, a.toString());
+    }
+
+    TEST_CASE("increment and decrement across limbs") {
+        BigInt a {"999999999999999999999999999"};
+        ++a;
+        const std::string expected {"1000000000000000000000000000"};
+
+        CHECK_EQ(expected, a.toString());
+        CHECK_EQ("999999999999999999999999999", (--a).toString());
+    }
+
+    TEST_CASE("addition and subtraction across limbs") {
+        const BigInt a {"999999999999999999"};
+        const BigInt b {"1"};
+        const std::string expected {"1000000000000000000"};
+
+        CHECK_EQ(expected, (a + b).toString());
+        CHECK_EQ(b, BigInt {expected} - a);
+    }
+
+    TEST_CASE("addition, subtraction and comparison kernels agree") {
+        std::mt19937 generator {12};
+        std::uniform_int_distribution<int> digit {0, 9};
+        // long runs of 9s & 0s make carries and borrows ripple across many lanes
+        const std::string alphabets[] {"0123456789", "9", "0", "09"};
+        auto randomBigInt = [&](std::size_t digits, const std::string& alphabet) {
+            std::string number(digits, '0');
+            for (auto& ch : number) {
+                ch = alphabet[digit(generator) % alphabet.size()];
+            }
+            number.front() = '1';
+            return BigInt {number};
+        };
+
+        const auto detected = limbs::detectLevel();
+        for (std::size_t digits : {20, 40, 75, 300, 1001}) {
+            for (const auto& alphabet : alphabets) {
+                const auto a = randomBigInt(digits, alphabet);
+                const auto b = randomBigInt(digits, alphabet);
+                const auto c = randomBigInt(digits / 3, alphabet);
+                const auto& larger = a < b ? b : a;
+                const auto& smaller = a < b ? a : b;
+
+                limbs::kernels = limbs::kernelsFor(limbs::Level::SCALAR);
+                const auto sum = a + b, shortSum = a + c;
+                const auto difference = larger - smaller, shortDifference = a - c;
+                const auto order = a < b;
+
+                for (auto level : {limbs::Level::SSE4, limbs::Level::AVX2}) {
+                    if (level > detected)
+                        break;
+                    limbs::kernels = limbs::kernelsFor(level);
+                    CHECK_EQ(sum, a + b);
+                    CHECK_EQ(shortSum, a + c);
+                    CHECK_EQ(difference, larger - smaller);
+                    CHECK_EQ(shortDifference, a - c);
+                    CHECK_EQ(order, a < b);
+                    CHECK_EQ(a, sum - b);
+                }
+            }
+        }
+        limbs::kernels = limbs::kernelsFor(detected);
+
+        const BigInt nines {std::string(200, '9')};
+        CHECK_EQ(BigInt {"1" + std::string(200, '0')}, nines + BigInt::one());
+        CHECK_EQ(nines, BigInt {"1" + std::string(200, '0')} - BigInt::one());
+        CHECK_LT(BigInt {std::string(199, '9') + "8"}, nines);
+    }
+
+    TEST_CASE("multiplication across limbs") {
+        const BigInt a {"123456789012345678901234567890"};
+        const BigInt b {"987654321098765432109876543210"};
+        const std::string expected {
+            "121932631137021795226185032733622923332237463801111263526900"};
+
+        CHECK_EQ(expected, (a * b).toString());
+        CHECK_EQ(expected, (b * a).toString());
+    }
+
+    TEST_CASE("division and modulo across limbs") {
+        const BigInt a {
+            "121932631137021795226185032733622923332237463801111263526900"};
+        const BigInt b {"1234567890123"};
+        const std::string expectedQ {"98765432109913086332308321346952414100582444977"};
+        const std::string expectedR {"443634264729"};
+
+        CHECK_EQ(expectedQ, (a / b).toString());
+        CHECK_EQ(expectedR, (a % b).toString());
+        CHECK_EQ(a, a / b * b + a % b);
+    }
+
+    TEST_CASE("small values across the native word boundary") {
+        const BigInt max {9'223'372'036'854'775'807uLL};
+        const BigInt limit {"9223372036854775808"};
+
+        BigInt a {max};
+        CHECK_EQ(limit, ++a);
+        CHECK_EQ(max, --a);
+        CHECK_EQ(limit, max + BigInt::one());
+        CHECK_EQ(max, limit - BigInt::one());
+        CHECK_LT(max, limit);
+        CHECK_GT(limit, max);
+        CHECK_EQ(limit.toULLong(), max.toULLong() + 1);
+        CHECK_EQ("18446744073709551614", (max + max).toString());
+        CHECK_EQ(19, max.length());
+        CHECK_EQ(20, (max * BigInt::ten()).length());
+
+        const BigInt word {4'294'967'296uLL};
+        CHECK_EQ("18446744073709551616", (word * word).toString());
+        CHECK_EQ(word, word * word / word);
+        CHECK_EQ(BigInt::zero(), word * word % word);
+        CHECK_EQ(BigInt {"000000000000000000000000123"}, BigInt {123uLL});
+    }
+
+    TEST_CASE("small values without heap allocations") {
+        BigInt a {123'456'789'012uLL}, b {"987654321"};
+
+        const auto allocations = countAllocations([&a, &b] {
+            for (int i {0}; i < 100; ++i) {
+                a += b;
+                a *= BigInt::ten();
+                a /= BigInt::ten();
+                a -= b;
+                ++a;
+            }
+        });
+        CHECK_EQ(0, allocations);
+        CHECK_EQ(BigInt {123'456'789'112uLL}, a);
+    }
+
+    TEST_CASE("divmod() when b = 0") {
+        const BigInt a {"123456"};
+
+        CHECK_THROWS_AS(divmod(a, BigInt::zero()), std::runtime_error);
+    }
+
+    TEST_CASE("divmod() returns quotient and remainder") {
+        const BigInt a {"1133873304647601"};
+        const BigInt b {"1000000007"};
+        const auto [quotient, remainder] = divmod(a, b);
+
+        CHECK_EQ("1133873", quotient.toString());
+        CHECK_EQ("296710490", remainder.toString());
+    }
+
+    TEST_CASE("divmod() when quotient limb estimate needs adding back") {
+        const BigInt a1 {"1500000000000000000013294794"};
+        const BigInt b1 {"500000000000000000499999999"};
+        const BigInt a2 {"999999999000000001000000000500000000"};
+        const BigInt b2 {"999999999000000001000000001"};
+        const auto [quotient1, remainder1] = divmod(a1, b1);
+        const auto [quotient2, remainder2] = divmod(a2, b2);
+
+        CHECK_EQ("2", quotient1.toString());
+        CHECK_EQ("499999999999999999013294796", remainder1.toString());
+        CHECK_EQ("999999999", quotient2.toString());
+        CHECK_EQ("999999999000000000500000001", remainder2.toString());
+    }
+
+    TEST_CASE("divmod() with multi-limb divisors") {
+        std::mt19937 generator {4};
+        std::uniform_int_distribution<int> digit {0, 9};
+        // skewed digits produce many quotient limb estimates that need correcting
+        const std::string alphabets[] {"0123456789", "09", "9", "0000000019"};
+        auto randomBigInt = [&](std::size_t digits, const std::string& alphabet) {
+            std::string number(digits, '0');
+            for (auto& ch : number) {
+                ch = alphabet[digit(generator) % alphabet.size()];
+            }
+            number[0] = '9';
+            return BigInt {number};
+        };
+
+        for (const auto& alphabet : alphabets) {
+            for (std::size_t aS : {19, 40, 100, 500}) {
+                for (std::size_t bS : {10, 18, 19, 27, 60, 200}) {
+                    const auto a = randomBigInt(aS, alphabet);
+                    const auto b = randomBigInt(bS, alphabet);
+                    const auto [quotient, remainder] = divmod(a, b);
+
+                    CHECK_LT(remainder, b);
+                    CHECK_EQ(a, quotient * b + remainder);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("divmod() by a machine word") {
+        const BigInt a {std::string(40, '9')};
+        const unsigned long long divisors[] {
+            7, 98765432109876543, 9223372036854788153uLL,
+            std::numeric_limits<unsigned long long>::max()
+        };
+        const std::string quotients[] {
+            "1428571428571428571428571428571428571428", "101249999988609375216437",
+            "1084202172485502982859", "542101086242752217033"
+        };
+        const unsigned long long remainders[] {
+            3, 68668044025662708, 6241555081964730572uLL, 2098486950404341704
+        };
+
+        for (int i {0}; i < 4; ++i) {
+            const auto [quotient, remainder] = divmod(a, divisors[i]);
+
+            CHECK_EQ(quotients[i], quotient.toString());
+            CHECK_EQ(remainders[i], remainder);
+        }
+    }
+
+    TEST_CASE("division and modulo by a machine word") {
+        BigInt a {"1133873304647601"};
+
+        CHECK_EQ(296710490uLL, a % 1'000'000'007uLL);
+        CHECK_EQ(BigInt {1133873uLL}, a / 1'000'000'000uLL);
+        CHECK_THROWS_AS(a / 0uLL, std::runtime_error);
+        CHECK_THROWS_AS(a % 0uLL, std::runtime_error);
+
+        a /= 3uLL;
+        CHECK_EQ(BigInt {377957768215867uLL}, a);
+        a %= 1'000'000uLL;
+        CHECK_EQ(BigInt {215867uLL}, a);
+    }
+
+    TEST_CASE("multiplication and addition by a machine word") {
+        BigInt a {"999999999999999999999999999"};
+
+        CHECK_EQ(a * BigInt {7uLL}, a * 7uLL);
+        CHECK_EQ(a * BigInt {999'999'999uLL}, a * 999'999'999uLL);
+        CHECK_EQ(a * BigInt {1uLL << 62}, a * (1uLL << 62));
+        CHECK_EQ(a * BigInt {UINT64_MAX}, a * UINT64_MAX);
+        CHECK_EQ(BigInt::zero(), a * 0uLL);
+        CHECK_EQ(BigInt {"18446744073709551615000"}, BigInt {UINT64_MAX} * 1000uLL);
+        CHECK_EQ(BigInt {"1000000000000000000000000000"}, a + 1uLL);
+        CHECK_EQ(a + BigInt {UINT64_MAX}, a + UINT64_MAX);
+        CHECK_EQ(BigInt {"18446744073709551615"}, BigInt {UINT64_MAX - 5} + 5uLL);
+        CHECK_EQ(BigInt {"36893488147419103230"}, BigInt {UINT64_MAX} + UINT64_MAX);
+
+        a *= 3uLL;
+        CHECK_EQ(BigInt {"2999999999999999999999999997"}, a);
+        a += 3uLL;
+        CHECK_EQ(BigInt {"3000000000000000000000000000"}, a);
+    }
+
+    TEST_CASE("productOf() and sumOf()") {
+        const std::vector<unsigned long long> empty;
+        CHECK_EQ(BigInt::one(), BigInt::productOf(empty));
+        CHECK_EQ(BigInt::zero(), BigInt::sumOf(empty));
+
+        const BigInt mixed[] {BigInt {"123456789012345678901234567890"}, BigInt {7uLL},
+                              BigInt::zero(), BigInt {"99999999999999999999"}};
+        CHECK_EQ(mixed[0] + mixed[1] + mixed[3], BigInt::sumOf(mixed));
+        CHECK_EQ(BigInt::zero(), BigInt::productOf(mixed));
+        CHECK_EQ(mixed[0] * mixed[1], BigInt::productOf(mixed, mixed + 2));
+
+        const auto threads = BigInt::reductionThreads;
+        std::vector<unsigned long long> values;
+        BigInt product {BigInt::one()}, sum;
+        for (unsigned long long i {1}; i <= 3000; ++i) {
+            values.push_back(i * i * i);
+            product *= BigInt {i * i * i};
+            sum += BigInt {i * i * i};
+        }
+        for (unsigned count : {1, 2, 3, 8}) {
+            BigInt::reductionThreads = count;
+            CHECK_EQ(product, BigInt::productOf(values));
+            CHECK_EQ(sum, BigInt::sumOf(values.cbegin(), values.cend()));
+        }
+        BigInt::reductionThreads = threads;
+    }
+
     TEST_CASE("pow() when exp = 0") {
         const BigInt a {"1000"};
         const BigInt b {BigInt::zero()};
@@ -604,6 +2742,63 @@ TEST_SUITE("test BigInt") {
         CHECK_EQ(expected, a.pow(b).toString());
     }
 
+    TEST_CASE("pow() with native exponent") {
+        CHECK_EQ(BigInt::one(), BigInt::zero().pow(0uLL));
+        CHECK_EQ(BigInt::zero(), BigInt::zero().pow(5uLL));
+        CHECK_EQ(BigInt::one(), BigInt::one().pow(1'000'000'000'000uLL));
+        CHECK_EQ("1" + std::string(100, '0'), BigInt::ten().pow(100uLL).toString());
+        CHECK_EQ("1267650600228229401496703205376", BigInt {2uLL}.pow(100uLL).toString());
+        CHECK_EQ(BigInt {"77782135939914677200873949156207143430037297002499"},
+                 BigInt {99uLL}.pow(25uLL));
+    }
+
+    TEST_CASE("pow() paths agree") {
+        const auto limit = BigInt::directPowLimit;
+        const BigInt bases[] {
+            BigInt {2uLL}, BigInt {3uLL}, BigInt {7uLL}, BigInt {12'345uLL},
+            BigInt {999'999'999uLL}, BigInt {"123456789012345678901"}
+        };
+
+        for (const auto& base : bases) {
+            for (unsigned long long exp : {2, 3, 17, 64, 333, 1000}) {
+                BigInt expected {BigInt::one()};
+                for (unsigned long long i {0}; i < exp; ++i) {
+                    expected *= base;
+                }
+
+                BigInt::directPowLimit = 0;
+                CHECK_EQ(expected, base.pow(exp));
+                BigInt::directPowLimit = SIZE_MAX;
+                CHECK_EQ(expected, base.pow(exp));
+                CHECK_EQ(expected, base.pow(BigInt {exp}));
+            }
+        }
+        BigInt::directPowLimit = limit;
+    }
+
+    TEST_CASE("squaring agrees with multiplication") {
+        const auto karatsuba = BigInt::karatsubaThreshold;
+        const auto toom3 = BigInt::toom3Threshold;
+        const auto ntt = BigInt::nttThreshold;
+
+        for (std::size_t digits : {5, 30, 200, 1000, 5000}) {
+            BigInt a {std::string(digits, '9')};
+            const BigInt copy {a};
+            const auto expected = a * copy;
+
+            CHECK_EQ(expected, a * a);
+            BigInt::karatsubaThreshold = 4;
+            BigInt::toom3Threshold = 40;
+            BigInt::nttThreshold = 300;
+            CHECK_EQ(expected, a * a);
+            a *= a;
+            CHECK_EQ(expected, a);
+            BigInt::karatsubaThreshold = karatsuba;
+            BigInt::toom3Threshold = toom3;
+            BigInt::nttThreshold = ntt;
+        }
+    }
+
     TEST_CASE("modPow() when exp = 0") {
         const BigInt base {"999"};
         const BigInt exp {BigInt::zero()};
@@ -653,4 +2848,248 @@ TEST_SUITE("test BigInt") {
         base = BigInt {"120"};
         CHECK_EQ(expectedB, base.modPow(exp, mod).toString());
     }
+
+    TEST_CASE("isqrt() and iroot()") {
+        CHECK_THROWS_AS(BigInt {8uLL}.iroot(0), std::invalid_argument);
+        CHECK_EQ(BigInt::zero(), BigInt::zero().isqrt());
+        CHECK_EQ(BigInt::one(), BigInt::one().iroot(5));
+        CHECK_EQ(BigInt {3uLL}, BigInt {15uLL}.isqrt());
+        CHECK_EQ(BigInt {4uLL}, BigInt {16uLL}.isqrt());
+        CHECK_EQ(BigInt {4294967295uLL}, BigInt {UINT64_MAX}.isqrt());
+        CHECK_EQ(BigInt {2uLL}, BigInt {2uLL}.pow(100uLL).iroot(99));
+        CHECK_EQ(BigInt::one(), BigInt {2uLL}.pow(100uLL).iroot(101));
+
+        const BigInt roots[] {BigInt {"999999999999999999999"},
+                              BigInt {"123456789012345678901234567890123"},
+                              BigInt {7uLL}.pow(200uLL)};
+        for (const auto& root : roots) {
+            for (unsigned long k : {2, 3, 7, 20}) {
+                const auto n = root.pow(k);
+                CHECK_EQ(root, n.iroot(k));
+                CHECK_EQ(root - BigInt::one(), (n - BigInt::one()).iroot(k));
+                CHECK_EQ(root, (n + BigInt::one()).iroot(k));
+            }
+        }
+    }
+
+    TEST_CASE("isPerfectPower()") {
+        BigInt base;
+        unsigned long exponent {};
+
+        CHECK(BigInt {64uLL}.isPerfectPower(&base, &exponent));
+        CHECK_EQ(BigInt {2uLL}, base);
+        CHECK_EQ(6, exponent);
+        CHECK(BigInt {6uLL}.pow(1000uLL).isPerfectPower(&base, &exponent));
+        CHECK_EQ(BigInt {6uLL}, base);
+        CHECK_EQ(1000, exponent);
+        const BigInt large {"123456789012345678901"};
+        CHECK(large.pow(15uLL).isPerfectPower(&base, &exponent));
+        CHECK_EQ(large, base);
+        CHECK_EQ(15, exponent);
+
+        const BigInt nonPowers[] {BigInt::zero(), BigInt::one(), BigInt {12uLL}, large,
+                                  BigInt {2uLL}.pow(100uLL) + BigInt::one(),
+                                  BigInt {6uLL}.pow(1000uLL) - BigInt::one()};
+        for (const auto& n : nonPowers) {
+            CHECK_FALSE(n.isPerfectPower());
+        }
+    }
+
+    TEST_CASE("gcd() and lcm() with small values") {
+        CHECK_EQ(BigInt::zero(), gcd(BigInt::zero(), BigInt::zero()));
+        CHECK_EQ(BigInt {12uLL}, gcd(BigInt {12uLL}, BigInt::zero()));
+        CHECK_EQ(BigInt {6uLL}, gcd(BigInt {12uLL}, BigInt {18uLL}));
+        CHECK_EQ(BigInt::one(), gcd(BigInt {17uLL}, BigInt {UINT64_MAX >> 1}));
+        CHECK_EQ(BigInt::zero(), lcm(BigInt::zero(), BigInt {5uLL}));
+        CHECK_EQ(BigInt {36uLL}, lcm(BigInt {12uLL}, BigInt {18uLL}));
+        CHECK_EQ(BigInt {"85070591730234615847396907784232501249"},
+                 lcm(BigInt {UINT64_MAX >> 1}, BigInt {UINT64_MAX >> 1}.pow(2uLL)));
+    }
+
+    TEST_CASE("gcd(), lcm() and extendedGcd() agree with Euclid's algorithm") {
+        std::mt19937_64 generator {18};
+        auto randomBigInt = [&](std::size_t digits) {
+            std::string number(digits, '0');
+            number[0] = static_cast<char>('1' + generator() % 9);
+            for (std::size_t i {1}; i < digits; ++i) {
+                number[i] = static_cast<char>('0' + generator() % 10);
+            }
+            return BigInt {number};
+        };
+        auto euclid = [](BigInt u, BigInt v) {
+            while (v != BigInt::zero()) {
+                u %= v;
+                std::swap(u, v);
+            }
+            return u;
+        };
+
+        for (int round {0}; round < 100; ++round) {
+            const auto common = randomBigInt(1 + generator() % 60);
+            const auto a = common * randomBigInt(1 + generator() % 300);
+            const auto b = common * randomBigInt(1 + generator() % 300);
+            const auto expected = euclid(a, b);
+
+            CHECK_EQ(expected, gcd(a, b));
+            CHECK_EQ(expected, gcd(b, a));
+            CHECK_EQ(a * b / expected, lcm(a, b));
+
+            const auto [g, x] = extendedGcd(a, b);
+            CHECK_EQ(expected, g);
+            CHECK_LT(x, b / g);
+            CHECK_EQ(g % b, a * x % b);
+        }
+    }
+
+    TEST_CASE("extendedGcd() edge cases") {
+        const BigInt large {"123456789012345678901234567890"};
+
+        CHECK_EQ(std::make_pair(large, BigInt::one()), extendedGcd(large, BigInt::zero()));
+        CHECK_EQ(std::make_pair(large, BigInt::zero()), extendedGcd(BigInt::zero(), large));
+        CHECK_EQ(std::make_pair(large, BigInt::zero()), extendedGcd(large, large));
+        // modular inverse of 3 mod 1e30 + 1
+        const auto modulus = BigInt::ten().pow(30uLL) + BigInt::one();
+        const auto [g, inverse] = extendedGcd(BigInt {3uLL}, modulus);
+        CHECK_EQ(BigInt::one(), g);
+        CHECK_EQ(BigInt::one(), BigInt {3uLL} * inverse % modulus);
+    }
+
+    TEST_CASE("temporaries in an arena scope") {
+        const BigInt x {"123456789012345678901234567890123456789"};
+        const auto expected = x * x * x + x * x * 30uLL + x * 26uLL + BigInt {3uLL};
+        BigInt result;
+        auto evaluate = [&x, &result] {
+            result = x * x * x + x * x * 30uLL + x * 26uLL + BigInt {3uLL};
+        };
+
+        const auto onHeap = countAllocations([&evaluate] {
+            for (int i {0}; i < 100; ++i) {
+                evaluate();
+            }
+        });
+        const auto inArena = countAllocations([&evaluate] {
+            for (int i {0}; i < 100; ++i) {
+                const ArenaScope scope;
+                evaluate();
+            }
+        });
+
+        CHECK_EQ(expected, result);
+        CHECK_GE(onHeap, 400);
+        // only the first iteration can grow the arena
+        CHECK_LE(inArena, 2);
+    }
+
+    TEST_CASE("values assigned out of an arena scope keep their own storage") {
+        Arena arena;
+        BigInt kept;
+        {
+            const ArenaScope scope {&arena};
+            BigInt temporary {"123456789012345678901234567890"};
+            temporary *= temporary;
+            kept = std::move(temporary);
+            CHECK_EQ(2, arena.allocations());
+        }
+        // overwrites the memory that the temporary used
+        {
+            const ArenaScope scope {&arena};
+            BigInt other {"999999999999999999999999999999999999999999999999999999999999"};
+        }
+
+        CHECK_EQ(BigInt {"15241578753238836750495351562536198787501905199875019052100"}, kept);
+        CHECK_EQ(kept, BigInt::productOf(std::vector<BigInt> {kept}));
+    }
+
+    TEST_CASE("values returned or moved out of an arena scope stay valid") {
+        Arena arena;
+        const BigInt x {"123456789012345678901234567890"};
+        auto scopedSquare = [&arena](const BigInt& value) {
+            const ArenaScope scope {&arena};
+            return value * value;
+        };
+
+        const auto squared = scopedSquare(x);
+        std::vector<BigInt> cubes;
+        {
+            const ArenaScope scope {&arena};
+            auto cube = x * x * x;
+            cubes.push_back(std::move(cube));
+        }
+        // overwrites all the memory that is free for reuse
+        {
+            const ArenaScope scope {&arena};
+            const auto capacity = arena.capacity();
+            for (std::size_t bytes {0}; bytes < capacity; bytes += 64) {
+                std::memset(arena.allocate(64, 4), 0xFF, 64);
+            }
+        }
+
+        CHECK_EQ(BigInt {"15241578753238836750495351562536198787501905199875019052100"},
+                 squared);
+        CHECK_EQ(x * squared, cubes.front());
+    }
+
+    TEST_CASE("closed form temporaries with an arena scope per evaluation") {
+        // sum of the diagonals of an n x n number spiral, modulo 1e9 + 7
+        auto formula = [](unsigned long long n) {
+            const BigInt x {(n - 1) / 2};
+            const auto sum = BigInt {16uLL} * x.pow(3uLL) + BigInt {30uLL} * x * x +
+                    BigInt {26uLL} * x + BigInt {3uLL};
+            return sum / 3uLL % 1'000'000'007uLL;
+        };
+        const unsigned long long start {999'999'999'999'999'001};
+        std::vector<unsigned long long> onHeap, inArena;
+
+        const auto heapAllocations = countAllocations([&formula, &onHeap, start] {
+            for (unsigned long long n {start}; n < start + 2000; n += 2) {
+                onHeap.push_back(formula(n));
+            }
+        });
+        inArena.reserve(onHeap.size());
+        const auto arenaAllocations = countAllocations([&formula, &inArena, start] {
+            for (unsigned long long n {start}; n < start + 2000; n += 2) {
+                const ArenaScope scope;
+                inArena.push_back(formula(n));
+            }
+        });
+
+        CHECK_EQ(669'171'001, formula(1001));
+        CHECK_EQ(onHeap, inArena);
+        CHECK_LT(100 * arenaAllocations, heapAllocations);
+    }
+
+    TEST_CASE("serialise() and deserialise()") {
+        const BigInt values[] {BigInt::zero(), BigInt {42uLL}, BigInt {UINT64_MAX},
+                               BigInt {"123456789012345678901234567890123456789"}};
+        std::stringstream stream;
+        for (const auto& value : values) {
+            value.serialise(stream);
+        }
+
+        for (const auto& value : values) {
+            CHECK_EQ(value, BigInt::deserialise(stream));
+        }
+        CHECK_THROWS_AS(BigInt::deserialise(stream), std::runtime_error);
+
+        std::stringstream bytes;
+        values[1].serialise(bytes);
+        // 1 limb of 42, little-endian
+        CHECK_EQ(std::string {"\x01\0\0\0\x2A\0\0\0", 8}, bytes.str());
+    }
+
+    TEST_CASE("deserialise() with invalid input") {
+        auto read = [](const std::string& bytes) {
+            std::stringstream stream {bytes};
+            return BigInt::deserialise(stream);
+        };
+
+        CHECK_THROWS_AS(read(std::string {"\0\0\0\0", 4}), std::runtime_error);
+        CHECK_THROWS_AS(read(std::string {"\x02\0\0\0\x01\0\0\0", 8}), std::runtime_error);
+        // limb of 1e9
+        CHECK_THROWS_AS(read(std::string {"\x01\0\0\0\0\xCA\x9A\x3B", 8}),
+                        std::runtime_error);
+        // leading zero limb
+        CHECK_THROWS_AS(read(std::string {"\x02\0\0\0\x01\0\0\0\0\0\0\0", 12}),
+                        std::runtime_error);
+    }
 }
\ No newline at end of file
@@ -2,53 +2,74 @@
 #define PROJECT_EULER_CPP_BIG_INT_H
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
 
 /*
  * Class representing data type that stores numbers with a potential for more than 20
  * digits (i.e. exceeding unsigned long long limits).
  *
  * The numbers are non-negative and standard mathematical operations are supported.
+ *
+ * Numbers are stored as limbs in base 1e9, so every limb holds 9 decimal digits and the
+ * product of 2 limbs fits in 64 bits. Keeping a decimal base means that toString() and
+ * the string constructors are the only conversion points and both remain linear.
+ *
+ * Values below 2^63 are instead kept inline as a native integer, without any heap
+ * storage, and use native arithmetic that checks for overflow. A value only spills into
+ * limbs when a result no longer fits, and every result that fits again is moved back
+ * inline, so each value has a single representation.
+ *
+ * Limbs are allocated from the heap, unless an ArenaScope is active on the current
+ * thread, in which case values created in the scope take their limbs from its arena.
+ * Expression-heavy loops can then open a scope per iteration, so that temporaries are
+ * released in bulk & their memory reused, instead of each reaching the heap.
  */
 class BigInt {
 public:
-    // digits are stored in reverse order
-    explicit BigInt(std::string& value)  {
-        m_digits.reserve(value.size());
-        for (std::size_t i = value.size(); i--;) {
-            if (!isdigit(value[i]))
-                throw std::invalid_argument("String must represent a number");
-            m_digits.push_back(value[i]);
-        }
-    }
-    explicit BigInt(const char* value)  {
-        m_digits.reserve(strlen(value));
-        for (std::size_t i = strlen(value); i--;) {
-            if (!isdigit(value[i]))
-                throw std::invalid_argument("String must represent a number");
-            m_digits.push_back(value[i]);
-        }
-    }
-    explicit BigInt(unsigned long long value)  {
-         do {
-            m_digits.push_back(value % 10 + '0');
-            value /= 10;
-         } while (value);
+    // limbs are stored in reverse order, i.e. least significant limb first
+    explicit BigInt(const std::string& value) { assign(value.data(), value.size()); }
+    explicit BigInt(const char* value) { assign(value, strlen(value)); }
+    explicit BigInt(unsigned long long value) { assignWord(value); }
+    BigInt(const BigInt& rhs) = default;
+    BigInt(BigInt&& rhs) noexcept = default;
+    BigInt& operator=(const BigInt& rhs) = default;
+    /*
+     * Not noexcept, as limbs bound to another arena, or to the heap instead of an arena,
+     * cannot be taken over & are copied into this value's own storage, which allocates.
+     */
+    BigInt& operator=(BigInt&& rhs);
+    BigInt() = default;
+
+    // shared immutable instances, so that no heap allocation happens per call
+    static const BigInt& zero()
+    {
+        static const BigInt value {0uLL};
+        return value;
     }
-    BigInt(const BigInt& rhs) {
-        m_digits = rhs.m_digits;
+    static const BigInt& one()
+    {
+        static const BigInt value {1uLL};
+        return value;
     }
-    BigInt() {
-        m_digits.push_back('0');
+    static const BigInt& ten()
+    {
+        static const BigInt value {10uLL};
+        return value;
     }
 
-    // way to create global namespace constants?
-    static BigInt zero() { return BigInt {0uLL}; }
-    static BigInt one() { return BigInt {1uLL}; }
-    static BigInt ten() { return BigInt {10uLL}; }
-
     friend bool operator==(const BigInt&, const BigInt&);
     friend bool operator!=(const BigInt&, const BigInt&);
     friend bool operator<(const BigInt&, const BigInt&);
@@ -66,37 +87,67 @@ public:
     BigInt operator--(int temp);
 
     friend BigInt& operator+=(BigInt&, const BigInt&);
-    friend BigInt operator+(const BigInt&, const BigInt&);
+    // left operands are taken by value, so that temporaries are reused instead of copied
+    friend BigInt operator+(BigInt, const BigInt&);
     friend BigInt& operator-=(BigInt&, const BigInt&);
-    friend BigInt operator-(const BigInt&, const BigInt&);
+    friend BigInt operator-(BigInt, const BigInt&);
+    // fast paths for operands that fit in a single machine word
+    friend BigInt& operator+=(BigInt&, unsigned long long);
+    friend BigInt operator+(BigInt, unsigned long long);
+
+    /*
+     * Operand sizes, in limbs of 9 digits, from which multiplication switches from the
+     * schoolbook method to Karatsuba, then to Toom-3, then to a number-theoretic
+     * transform. The defaults are based on the crossover benchmark found with the tests
+     * for this class.
+     */
+    static inline std::size_t karatsubaThreshold {48};
+    static inline std::size_t toom3Threshold {192};
+    static inline std::size_t nttThreshold {1024};
+    // result size, in limbs, below which pow() of a single-limb base avoids squaring
+    static inline std::size_t directPowLimit {12};
+    // threads used by productOf() & sumOf(), with 0 meaning the hardware concurrency
+    static inline unsigned reductionThreads {0};
 
     friend BigInt& operator*=(BigInt&, const BigInt&);
     friend BigInt operator*(const BigInt&, const BigInt&);
+    friend BigInt& operator*=(BigInt&, unsigned long long);
+    friend BigInt operator*(BigInt, unsigned long long);
+    friend std::pair<BigInt, BigInt> divmod(const BigInt&, const BigInt&);
     friend BigInt& operator/=(BigInt&, const BigInt&);
     friend BigInt operator/(const BigInt&, const BigInt&);
     friend BigInt& operator%=(BigInt&, const BigInt&);
     friend BigInt operator%(const BigInt&, const BigInt&);
 
+    // fast paths for divisors that fit in a single machine word
+    friend std::pair<BigInt, unsigned long long> divmod(const BigInt&, unsigned long long);
+    friend BigInt& operator/=(BigInt&, unsigned long long);
+    friend BigInt operator/(const BigInt&, unsigned long long);
+    friend BigInt& operator%=(BigInt&, unsigned long long);
+    friend unsigned long long operator%(const BigInt&, unsigned long long);
+
+    friend BigInt gcd(const BigInt&, const BigInt&);
+    friend BigInt lcm(const BigInt&, const BigInt&);
+    /*
+     * @return pair of {gcd g, x}, such that a * x = g (mod b), with 0 <= x < b / g, or
+     * x = 1 if b = 0. If g = 1, x is the modular inverse of a.
+     */
+    friend std::pair<BigInt, BigInt> extendedGcd(const BigInt&, const BigInt&);
+
+    BigInt pow(unsigned long long exp) const;
     BigInt pow(const BigInt& exp) const
     {
-        if (exp == BigInt::zero())
-            return BigInt::one();
+        if (exp.isSmall())
+            return pow(exp.m_small);
 
         BigInt base {*this}, exponent {exp}, result {1uLL};
 
-        while (!(exponent.length() == 1 && exponent.m_digits[0] == '0')) {
-            if (exponent.m_digits[0] - '0' & 1)
+        while (!exponent.isZero()) {
+            if (exponent.isOdd())
                 result *= base;
-            base *= base;
-            int add {};
-            for (int i = exponent.length() - 1; i >= 0; --i) {
-                auto digit = ((exponent.m_digits[i] - '0') >> 1) + add;
-                add = (exponent.m_digits[i] - '0' & 1) * 5;
-                exponent.m_digits[i] = digit + '0';
-            }
-            while (exponent.length() > 1 && !(exponent.m_digits.back() - '0')) {
-                exponent.m_digits.pop_back();
-            }
+            exponent.halve();
+            if (!exponent.isZero())
+                base *= base;
         }
 
         return result;
@@ -114,42 +165,357 @@ public:
         if (base == BigInt::zero())
             return base;
 
-        while (!(exponent.length() == 1 && exponent.m_digits[0] == '0')) {
-            if (exponent.m_digits[0] - '0' & 1)
+        while (!exponent.isZero()) {
+            if (exponent.isOdd())
                 result = result * base % mod;
-            base = base * base % mod;
-            int add {};
-            for (int i = exponent.length() - 1; i >= 0; --i) {
-                auto digit = ((exponent.m_digits[i] - '0') >> 1) + add;
-                add = (exponent.m_digits[i] - '0' & 1) * 5;
-                exponent.m_digits[i] = digit + '0';
-            }
-            while (exponent.length() > 1 && !(exponent.m_digits.back() - '0')) {
-                exponent.m_digits.pop_back();
-            }
+            exponent.halve();
+            if (!exponent.isZero())
+                base = base * base % mod;
         }
 
         return result;
     }
 
-    std::size_t length() const { return m_digits.size(); }
+    /*
+     * @return floor of the kth root of this number.
+     * @throws std::invalid_argument if k = 0.
+     */
+    BigInt iroot(unsigned long k) const;
+    BigInt isqrt() const { return iroot(2); }
+    /*
+     * @return true if this number equals m^e for integers m > 1 & e > 1, in which case m
+     * & the largest such e are stored in base & exponent, if provided.
+     */
+    bool isPerfectPower(BigInt* base = nullptr, unsigned long* exponent = nullptr) const;
 
-    std::string toString() const
+    /*
+     * @return product of all values in the range, which may hold BigInt or unsigned
+     * integers, or 1 if the range is empty.
+     *
+     * The product is evaluated as a balanced tree, so that every multiplication has
+     * operands of similar size that benefit from the faster algorithms, instead of a
+     * growing product being multiplied by one small factor at a time. Independent
+     * subtrees are evaluated on separate threads, up to reductionThreads.
+     */
+    template <typename It>
+    static BigInt productOf(It first, It last)
+    {
+        auto values = collect(first, last);
+        return reduceTree(values, 0, values.size(), threadBudget(), true);
+    }
+    template <typename Range>
+    static BigInt productOf(const Range& range)
     {
-        return std::string {m_digits.rbegin(), m_digits.rend()};
+        return productOf(std::begin(range), std::end(range));
     }
+    /*
+     * @return sum of all values in the range, or 0 if the range is empty, with chunks of
+     * the range summed in place on separate threads, then combined as a balanced tree.
+     */
+    template <typename It>
+    static BigInt sumOf(It first, It last)
+    {
+        auto values = collect(first, last);
+        return reduceTree(values, 0, values.size(), threadBudget(), false);
+    }
+    template <typename Range>
+    static BigInt sumOf(const Range& range)
+    {
+        return sumOf(std::begin(range), std::end(range));
+    }
+
+    /*
+     * @return amount of decimal digits in this number.
+     */
+    std::size_t length() const
+    {
+        std::size_t digits {1};
+        if (isSmall()) {
+            for (auto value = m_small; value >= 10; value /= 10) {
+                digits++;
+            }
+            return digits;
+        }
+
+        for (auto top = m_limbs.back(); top >= 10; top /= 10) {
+            digits++;
+        }
+
+        return (m_limbs.size() - 1) * BASE_DIGITS + digits;
+    }
+
+    std::string toString() const;
+    /*
+     * @return the first k digits of this number, or all digits if there are fewer,
+     * without converting the whole number to a string.
+     */
+    std::string leadingDigits(std::size_t k) const;
+    /*
+     * @return sum of the decimal digits of this number, without converting it to a
+     * string.
+     */
+    unsigned long digitSum() const;
+    /*
+     * @return well-distributed 64-bit hash of this number, which equal numbers always
+     * share, so that differing fingerprints prove inequality without comparing limbs.
+     *
+     * The fingerprint of a number stored as limbs is computed in a single pass, then
+     * cached in the object until its value changes. The cache is a relaxed atomic, so
+     * shared instances can be fingerprinted & compared from many threads at once.
+     */
+    std::uint64_t fingerprint() const;
     /*
      * @throws std::out_of_range if converted value would overflow unsigned long range.
      */
-    unsigned long toULong() const { return std::stoul(this -> toString()); }
+    unsigned long toULong() const;
     /*
      * @throws std::out_of_range if converted value would overflow unsigned long long
      * range.
      */
-    unsigned long long toULLong() const { return std::stoull(this -> toString()); }
+    unsigned long long toULLong() const;
+
+    /*
+     * Writes this number as a little-endian 32-bit limb count, followed by its base 1e9
+     * limbs as little-endian 32-bit words, least significant first.
+     */
+    void serialise(std::ostream& out) const;
+    /*
+     * @throws std::runtime_error if the stream ends early or does not hold a number
+     * written by serialise().
+     */
+    static BigInt deserialise(std::istream& in);
 
 protected:
-    std::vector<unsigned char> m_digits;
+    template <typename T>
+    friend class MontgomeryContext;
+    friend class BigIntAccumulator;
+    friend class BigIntView;
+    friend class BigIntTableView;
+    template <std::size_t Bits>
+    friend class UInt;
+
+    static constexpr std::uint32_t BASE {1'000'000'000};
+    static constexpr int BASE_DIGITS {9};
+
+    static constexpr std::uint64_t SMALL_LIMIT {1uLL << 63};
+
+    // limb storage comes from the arena of an enclosing ArenaScope, if there is one
+    using Limbs = std::vector<std::uint32_t, ArenaAllocator<std::uint32_t>>;
+
+    // the value itself while m_limbs is empty, otherwise unused
+    std::uint64_t m_small {};
+    Limbs m_limbs;
+    /*
+     * Word accessed with relaxed atomics, so that const instances shared between threads
+     * can fill it in concurrently. Copies take its current value, so that BigInt keeps
+     * its defaulted copy operations.
+     */
+    class FingerprintCache {
+    public:
+        FingerprintCache() = default;
+        FingerprintCache(const FingerprintCache& rhs) noexcept : m_value {rhs.load()} {}
+        FingerprintCache& operator=(const FingerprintCache& rhs) noexcept
+        {
+            store(rhs.load());
+            return *this;
+        }
+
+        std::uint64_t load() const { return m_value.load(std::memory_order_relaxed); }
+        void store(std::uint64_t value) { m_value.store(value, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<std::uint64_t> m_value {};
+    };
+
+    // cached fingerprint of the limbs, with 0 meaning not yet computed
+    mutable FingerprintCache m_fingerprint;
+
+    bool isSmall() const { return m_limbs.empty(); }
+    bool isZero() const
+    {
+        return isSmall() ? !m_small : m_limbs.size() == 1 && !m_limbs[0];
+    }
+    bool isOdd() const { return (isSmall() ? m_small : m_limbs[0]) & 1; }
+    // removes leading zero limbs, while always keeping at least 1 limb
+    void trim()
+    {
+        while (m_limbs.size() > 1 && !m_limbs.back()) {
+            m_limbs.pop_back();
+        }
+    }
+    // in-place integer division by 2, as used to walk the bits of an exponent
+    void halve()
+    {
+        if (isSmall()) {
+            m_small >>= 1;
+            return;
+        }
+
+        std::uint32_t carryOver {};
+        for (std::size_t i = m_limbs.size(); i--;) {
+            std::uint64_t current = m_limbs[i] + 1uLL * carryOver * BASE;
+            m_limbs[i] = current >> 1;
+            carryOver = current & 1;
+        }
+        normalise();
+    }
+
+    // stores value inline if it fits, otherwise as limbs, reusing any limb capacity
+    void assignWord(std::uint64_t value)
+    {
+        m_fingerprint.store(0);
+        m_limbs.clear();
+        if (value < SMALL_LIMIT) {
+            m_small = value;
+            return;
+        }
+
+        do {
+            m_limbs.push_back(value % BASE);
+            value /= BASE;
+        } while (value);
+    }
+    // moves an inline value into limbs, before limbs are modified in place
+    void spill()
+    {
+        if (!isSmall())
+            return;
+
+        auto value = m_small;
+        do {
+            m_limbs.push_back(value % BASE);
+            value /= BASE;
+        } while (value);
+    }
+    // trims limbs, then moves the value back inline if it now fits
+    void normalise()
+    {
+        m_fingerprint.store(0);
+        trim();
+        // 1e19 > 2^63, so only values of at most 2 full limbs & a top limb < 10 can fit
+        const auto size = m_limbs.size();
+        if (!size || size > 3 || (size == 3 && m_limbs[2] >= 10))
+            return;
+
+        std::uint64_t value {};
+        for (std::size_t i = size; i--;) {
+            value = value * BASE + m_limbs[i];
+        }
+        if (value < SMALL_LIMIT) {
+            m_limbs.clear();
+            m_small = value;
+        }
+    }
+
+    /*
+     * Read-only limbs of a value in either representation, with an inline value split
+     * into local storage, so that limb algorithms accept both without allocating.
+     */
+    struct LimbView {
+        explicit LimbView(const BigInt& x)
+        {
+            if (!x.isSmall()) {
+                data = x.m_limbs.data();
+                size = x.m_limbs.size();
+                return;
+            }
+
+            auto value = x.m_small;
+            do {
+                local[size++] = value % BASE;
+                value /= BASE;
+            } while (value);
+        }
+        LimbView(const LimbView&) = delete;
+        LimbView& operator=(const LimbView&) = delete;
+
+        std::uint32_t operator[](std::size_t i) const { return data[i]; }
+        std::uint32_t back() const { return data[size-1]; }
+
+        std::uint32_t local[3] {};
+        const std::uint32_t* data {local};
+        std::size_t size {};
+    };
+
+private:
+    explicit BigInt(Limbs&& limbs) : m_limbs {std::move(limbs)}
+    {
+        normalise();
+    }
+
+    void assign(const char* value, std::size_t size);
+    static int compare(const BigInt& a, const BigInt& b);
+    // limb kernels shared with BigIntView, for trimmed limbs that may be stored elsewhere
+    static int compare(const std::uint32_t* a, std::size_t aS,
+                       const std::uint32_t* b, std::size_t bS);
+    static void addLimbs(BigInt& a, const std::uint32_t* b, std::size_t bS);
+    // throws std::invalid_argument if b > a
+    static void subLimbs(BigInt& a, const std::uint32_t* b, std::size_t bS);
+    static std::string toString(const std::uint32_t* limbs, std::size_t size);
+    // stores a * b in product, unless the result would overflow 64 bits
+    static bool multiplyWords(std::uint64_t a, std::uint64_t b, std::uint64_t& product)
+    {
+#ifdef __SIZEOF_INT128__
+        const auto wide = static_cast<unsigned __int128>(a) * b;
+        product = static_cast<std::uint64_t>(wide);
+        return !(wide >> 64);
+#else
+        if (a && b > std::numeric_limits<std::uint64_t>::max() / a)
+            return false;
+        product = a * b;
+        return true;
+#endif
+    }
+    static BigInt slice(const BigInt& x, std::size_t from, std::size_t count);
+    static void addShifted(BigInt& acc, const BigInt& x, std::size_t shift);
+    // in-place single passes over the limbs of a, for m & w below BASE
+    static void mulWord(BigInt& a, std::uint32_t m) { mulAddWord(a, m, 0); }
+    static void addWord(BigInt& a, std::uint64_t w);
+    static void mulAddWord(BigInt& a, std::uint32_t m, std::uint32_t w);
+    static unsigned long long divideByWord(const BigInt& a, unsigned long long d,
+                                           BigInt* quotient);
+    static BigInt multiply(const BigInt& a, const BigInt& b);
+    static BigInt mulSchoolbook(const BigInt& a, const BigInt& b);
+    static void mulSchoolbook(const BigInt& a, const BigInt& b,
+                              Limbs& product);
+    static BigInt mulKaratsuba(const BigInt& a, const BigInt& b);
+    static BigInt mulToom3(const BigInt& a, const BigInt& b);
+    static BigInt mulNTT(const BigInt& a, const BigInt& b);
+    static BigInt square(const BigInt& a);
+    static BigInt sqrSchoolbook(const BigInt& a);
+    // cofactors of u & v for as many Euclid steps as their leading limbs predict
+    static unsigned lehmerCofactors(const BigInt& u, const BigInt& v,
+                                    std::int64_t (&cofactors)[4]);
+    // x * u + y * v, for |x| & |y| at most BASE and a result known to be in [0, u]
+    static BigInt combine(const BigInt& u, const BigInt& v, std::int64_t x, std::int64_t y);
+
+    template <typename It>
+    static std::vector<BigInt> collect(It first, It last)
+    {
+        // values are handed to other threads, so cannot use this thread's arena
+        const ArenaScope heap {nullptr};
+        std::vector<BigInt> values;
+        for (; first != last; ++first) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(*first)>, BigInt>)
+                values.push_back(*first);
+            else
+                values.emplace_back(static_cast<unsigned long long>(*first));
+        }
+        return values;
+    }
+    static unsigned threadBudget();
+    static BigInt reduceTree(std::vector<BigInt>& values, std::size_t from,
+                             std::size_t to, unsigned threads, bool multiply);
 };
 
-#endif //PROJECT_EULER_CPP_BIG_INT_H
\ No newline at end of file
+namespace std {
+    template <>
+    struct hash<BigInt> {
+        std::size_t operator()(const BigInt& value) const noexcept
+        {
+            return static_cast<std::size_t>(value.fingerprint());
+        }
+    };
+}
+
+#endif //PROJECT_EULER_CPP_BIG_INT_H
@@ -0,0 +1,199 @@
+#include "decimal-expansion.h"
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "../../doctest/doctest.h"
+
+namespace {
+    std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, std::uint64_t m)
+    {
+        std::uint64_t high {}, remainder;
+        const auto low = uint_detail::mulAdd(a, b, 0, 0, high);
+        uint_detail::divWide(high, low, m, remainder);
+        return remainder;
+    }
+
+    std::uint64_t powMod(std::uint64_t base, std::uint64_t exponent, std::uint64_t m)
+    {
+        std::uint64_t result {1 % m};
+        base %= m;
+        while (exponent) {
+            if (exponent & 1)
+                result = mulMod(result, base, m);
+            base = mulMod(base, base, m);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    std::vector<std::uint64_t> distinctPrimes(std::uint64_t n)
+    {
+        std::vector<std::uint64_t> primes;
+        for (std::uint64_t p {2}; p * p <= n; ++p) {
+            if (n % p)
+                continue;
+            primes.push_back(p);
+            while (!(n % p)) {
+                n /= p;
+            }
+        }
+        if (n > 1)
+            primes.push_back(n);
+        return primes;
+    }
+
+    std::map<unsigned long long, unsigned long> factorise(unsigned long long n)
+    {
+        std::map<unsigned long long, unsigned long> factors;
+        for (unsigned long long p {2}; p * p <= n; ++p) {
+            while (!(n % p)) {
+                factors[p]++;
+                n /= p;
+            }
+        }
+        if (n > 1)
+            factors[n]++;
+        return factors;
+    }
+}
+
+/*
+ * The order modulo m is the lcm of the orders modulo each prime power p^e of m, each of
+ * which divides phi(p^e) = p^(e-1) * (p - 1). So the order modulo p^e is found by
+ * starting from phi(p^e) & dividing out each of its prime factors for as long as the
+ * result remains a power that gives 1.
+ *
+ * Only p - 1 needs to be factored, by trial division, which takes O(sqrt p) steps.
+ *
+ * Every prime power is reduced modulo 64-bit words, so larger ones are rejected rather
+ * than left to silently wrap around.
+ */
+unsigned long long multiplicativeOrder(
+        unsigned long long base, const std::map<unsigned long long, unsigned long>& factors)
+{
+    unsigned long long order {1};
+    for (const auto& [p, exponent] : factors) {
+        if (!(base % p))
+            throw std::invalid_argument("Base must be co-prime with the modulus");
+
+        std::uint64_t power {p}, phi {p - 1};
+        for (unsigned long i {1}; i < exponent; ++i) {
+            if (power > UINT64_MAX / p)
+                throw std::out_of_range("Prime power of the modulus exceeds 64 bits");
+            power *= p;
+            phi *= p;
+        }
+        auto primes = distinctPrimes(p - 1);
+        if (exponent > 1)
+            primes.push_back(p);
+
+        auto primeOrder = phi;
+        for (const auto q : primes) {
+            while (!(primeOrder % q) && powMod(base, primeOrder / q, power) == 1) {
+                primeOrder /= q;
+            }
+        }
+        const auto multiple = primeOrder / std::gcd(order, primeOrder);
+        if (order > UINT64_MAX / multiple)
+            throw std::out_of_range("Order exceeds 64 bits");
+        order *= multiple;
+    }
+
+    return order;
+}
+
+TEST_SUITE("test DecimalExpansion") {
+    TEST_CASE("digits") {
+        DecimalExpansion<unsigned long long> seventh {22, 7};
+        CHECK_EQ(3, seventh.integerPart());
+        CHECK_EQ(1, seventh.nextDigit());
+        CHECK_EQ("42857142857", seventh.nextDigits(11));
+
+        DecimalExpansion<unsigned long long> eighth {1, 8};
+        CHECK_EQ("12500", eighth.nextDigits(5));
+
+        DecimalExpansion<unsigned long long> wide {(1uLL << 63) - 1, (1uLL << 63) + 1};
+        CHECK_EQ(0, wide.integerPart());
+        CHECK_EQ("99999999999999999978", wide.nextDigits(20));
+
+        DecimalExpansion<BigInt> big {BigInt::one(), BigInt {"100000000000000000000003"}};
+        CHECK_EQ(BigInt::zero(), big.integerPart());
+        CHECK_EQ("00000000000000000000000999999", big.nextDigits(29));
+
+        CHECK_THROWS_AS(DecimalExpansion<unsigned long long>(1, 0), std::invalid_argument);
+        CHECK_THROWS_AS(DecimalExpansion<BigInt>(BigInt::one(), BigInt::zero()),
+                        std::invalid_argument);
+    }
+
+    TEST_CASE("cycles") {
+        using Expansion = DecimalExpansion<unsigned long long>;
+        const std::vector<std::array<unsigned long long, 4>> cases {
+            // numerator, denominator, pre-period, period
+            {1, 7, 0, 6}, {1, 6, 1, 1}, {1, 8, 3, 0}, {1, 27, 0, 3}, {1, 3, 0, 1},
+            {5, 10, 1, 0}, {0, 13, 0, 0}, {14, 7, 0, 0}, {1, 1, 0, 0}, {7, 12, 2, 1},
+            {3, 28, 2, 6}, {1, 97, 0, 96}, {1, 1'000'000, 6, 0}, {21, 49, 0, 6}
+        };
+        for (const auto& [a, b, preperiod, period] : cases) {
+            const Expansion expansion {a, b};
+            CAPTURE(b);
+            CHECK_EQ(preperiod, expansion.cycle().preperiod);
+            CHECK_EQ(period, expansion.cycle().period);
+            CHECK_EQ(preperiod, expansion.cycle(factorise(b)).preperiod);
+            CHECK_EQ(period, expansion.cycle(factorise(b)).period);
+        }
+
+        CHECK_EQ(9'999'942, Expansion {1, 9'999'943}.cycle().period);
+        CHECK_EQ(9'999'942, Expansion {1, 9'999'943}.cycle(factorise(9'999'943)).period);
+
+        const DecimalExpansion<BigInt> nines {BigInt::one(), BigInt {std::string(30, '9')}};
+        CHECK_EQ(0, nines.cycle().preperiod);
+        CHECK_EQ(30, nines.cycle().period);
+        const DecimalExpansion<BigInt> big {BigInt {"3" + std::string(30, '0')},
+                                            BigInt {"7" + std::string(55, '0')}};
+        CHECK_EQ(25, big.cycle().preperiod);
+        CHECK_EQ(6, big.cycle().period);
+        CHECK_EQ(25, big.cycle({{2, 55}, {5, 55}, {7, 1}}).preperiod);
+        CHECK_EQ(6, big.cycle({{2, 55}, {5, 55}, {7, 1}}).period);
+
+        // period 6 * 7^29 does not fit in 64 bits
+        const DecimalExpansion<BigInt> wide {BigInt::one(), BigInt {7uLL}.pow(30uLL)};
+        CHECK_THROWS_AS(wide.cycle({{7, 30}}), std::out_of_range);
+
+        const std::map<unsigned long long, unsigned long> wrongFactors {{2, 1}, {3, 1}};
+        CHECK_THROWS_AS(Expansion(1, 12).cycle(wrongFactors), std::invalid_argument);
+    }
+
+    TEST_CASE("closed form agrees with cycle detection") {
+        for (unsigned long long b {1}; b <= 2000; ++b) {
+            for (const unsigned long long a : {1uLL, 3uLL, 10uLL, b - 1}) {
+                const DecimalExpansion<unsigned long long> expansion {a, b};
+                const auto detected = expansion.cycle();
+                const auto closed = expansion.cycle(factorise(b));
+                CAPTURE(a);
+                CAPTURE(b);
+                CHECK_EQ(detected.preperiod, closed.preperiod);
+                CHECK_EQ(detected.period, closed.period);
+            }
+        }
+    }
+
+    TEST_CASE("multiplicative order") {
+        CHECK_EQ(1, multiplicativeOrder(10, {}));
+        CHECK_EQ(2, multiplicativeOrder(3, {{2, 3}}));
+        CHECK_EQ(8, multiplicativeOrder(2, {{17, 1}}));
+        CHECK_EQ(48, multiplicativeOrder(3, {{7, 1}, {17, 1}}));
+        CHECK_EQ(42, multiplicativeOrder(10, {{7, 2}}));
+        CHECK_EQ(81, multiplicativeOrder(10, {{3, 6}}));
+        CHECK_EQ(3'351'275'184'499'704'042, multiplicativeOrder(10, {{7, 22}}));
+        CHECK_THROWS_AS(multiplicativeOrder(10, {{5, 1}}), std::invalid_argument);
+        // 7^23 > 2^64
+        CHECK_THROWS_AS(multiplicativeOrder(10, {{7, 23}}), std::out_of_range);
+        // orders 999'999'999'988 & 499'999'999'980 have an lcm > 2^64
+        const std::map<unsigned long long, unsigned long> largePrimes {
+            {999'999'999'961, 1}, {999'999'999'989, 1}
+        };
+        CHECK_THROWS_AS(multiplicativeOrder(10, largePrimes), std::out_of_range);
+    }
+}
@@ -0,0 +1,189 @@
+#ifndef PROJECT_EULER_CPP_DECIMAL_EXPANSION_H
+#define PROJECT_EULER_CPP_DECIMAL_EXPANSION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "big-int.h"
+#include "uint.h"
+
+/*
+ * @return smallest k > 0 such that base^k = 1 (mod m), given the prime factorisation of
+ * m, in the same form as returned by primeFactors().
+ * @throws std::invalid_argument if base & m are not co-prime.
+ * @throws std::out_of_range if a prime power of m, or the order, exceeds 64 bits.
+ */
+unsigned long long multiplicativeOrder(
+        unsigned long long base, const std::map<unsigned long long, unsigned long>& factors);
+
+namespace decimal_detail {
+    /*
+     * Moves the remainder r of a division by d on by 1 decimal digit.
+     *
+     * @return the digit produced.
+     */
+    inline unsigned nextDigit(unsigned long long& r, unsigned long long d)
+    {
+        std::uint64_t high {}, remainder;
+        const auto low = uint_detail::mulAdd(r, 10, 0, 0, high);
+        const auto digit = uint_detail::divWide(high, low, d, remainder);
+        r = remainder;
+        return static_cast<unsigned>(digit);
+    }
+    inline unsigned nextDigit(BigInt& r, const BigInt& d)
+    {
+        r *= 10uLL;
+        auto [digit, remainder] = divmod(r, d);
+        r = std::move(remainder);
+        return static_cast<unsigned>(digit.toULLong());
+    }
+
+    inline bool isZero(unsigned long long x) { return !x; }
+    inline bool isZero(const BigInt& x) { return x == BigInt::zero(); }
+}
+
+/*
+ * Decimal expansion of a non-negative fraction a/b, with its fractional digits streamed
+ * one at a time, for a denominator that is either a machine word or a BigInt.
+ *
+ * Every digit is determined by the remainder left by the previous one, r' = 10r mod b,
+ * so the digits repeat as soon as a remainder does. The pre-period, i.e. the amount of
+ * digits before the repetend, & the period, i.e. the length of the repetend, are found
+ * by running Brent's cycle detection on the remainders, which takes O(pre-period +
+ * period) steps, but only a few remainders of memory. Expansions that terminate have a
+ * period of 0.
+ *
+ * If the factorisation of a word-size b is known, the period is instead found directly
+ * as the multiplicative order of 10 modulo the part of b that is co-prime to 10.
+ */
+template <typename T>
+class DecimalExpansion {
+public:
+    struct Cycle {
+        unsigned long long preperiod;
+        unsigned long long period;
+    };
+
+    /*
+     * @throws std::invalid_argument if denominator = 0.
+     */
+    DecimalExpansion(const T& numerator, const T& denominator)
+        : m_denominator {denominator}, m_integer {}, m_start {}, m_remainder {}
+    {
+        if (decimal_detail::isZero(denominator))
+            throw std::invalid_argument("Denominator must be positive");
+
+        m_integer = numerator / denominator;
+        m_start = numerator % denominator;
+        m_remainder = m_start;
+    }
+
+    const T& integerPart() const { return m_integer; }
+
+    // digits after the last one streamed repeat with the same period as from the start
+    unsigned nextDigit() { return decimal_detail::nextDigit(m_remainder, m_denominator); }
+    /*
+     * @return the next count fractional digits, as a string.
+     */
+    std::string nextDigits(std::size_t count)
+    {
+        std::string digits(count, '0');
+        for (auto& digit : digits) {
+            digit = static_cast<char>('0' + nextDigit());
+        }
+        return digits;
+    }
+
+    /*
+     * Brent's algorithm finds the period first, as the distance that a hare travels from
+     * a tortoise that teleports to it at every power of 2 steps. The pre-period is then
+     * the amount of steps that 2 pointers, the period apart, take to meet.
+     */
+    Cycle cycle() const
+    {
+        auto step = [this](T& r) { decimal_detail::nextDigit(r, m_denominator); };
+        unsigned long long power {1}, period {1};
+        T tortoise {m_start}, hare {m_start};
+        step(hare);
+        while (tortoise != hare) {
+            if (power == period) {
+                tortoise = hare;
+                power *= 2;
+                period = 0;
+            }
+            step(hare);
+            period++;
+        }
+
+        unsigned long long preperiod {};
+        tortoise = m_start;
+        hare = m_start;
+        for (unsigned long long i {0}; i < period; ++i) {
+            step(hare);
+        }
+        while (tortoise != hare) {
+            step(tortoise);
+            step(hare);
+            preperiod++;
+        }
+
+        // a terminating expansion ends in a cycle of remainder 0
+        return {preperiod, decimal_detail::isZero(tortoise) ? 0 : period};
+    }
+    /*
+     * The fraction is first reduced, by removing the primes that also divide the
+     * numerator. Its pre-period is then the larger exponent of 2 & 5 in what is left of
+     * the denominator, while its period is the multiplicative order of 10 modulo the
+     * rest.
+     *
+     * @param factors prime factorisation of the denominator, in the same form as
+     * returned by primeFactors().
+     * @throws std::invalid_argument if the factors do not multiply to the denominator.
+     * @throws std::out_of_range if a prime power of the denominator, or the period,
+     * exceeds 64 bits.
+     */
+    Cycle cycle(const std::map<unsigned long long, unsigned long>& factors) const
+    {
+        T product {1uLL};
+        std::map<unsigned long long, unsigned long> coPrime;
+        unsigned long twos {}, fives {};
+        for (auto [p, exponent] : factors) {
+            for (unsigned long i {0}; i < exponent; ++i) {
+                product *= p;
+            }
+            // numerator is co-prime with p once its remainder is not a multiple
+            auto reduced = m_start;
+            while (exponent && decimal_detail::isZero(reduced % p)) {
+                reduced /= p;
+                exponent--;
+            }
+            if (!exponent)
+                continue;
+            if (p == 2)
+                twos = exponent;
+            else if (p == 5)
+                fives = exponent;
+            else
+                coPrime[p] = exponent;
+        }
+        if (product != m_denominator)
+            throw std::invalid_argument("Factors must multiply to the denominator");
+        if (decimal_detail::isZero(m_start))
+            return {0, 0};
+
+        const unsigned long long preperiod {std::max(twos, fives)};
+        return {preperiod, coPrime.empty() ? 0 : multiplicativeOrder(10, coPrime)};
+    }
+
+private:
+    T m_denominator;
+    T m_integer;
+    // remainder before the first fractional digit
+    T m_start;
+    T m_remainder;
+};
+
+#endif //PROJECT_EULER_CPP_DECIMAL_EXPANSION_H
@@ -0,0 +1,298 @@
+#include "montgomery.h"
+
+#include "../../doctest/doctest.h"
+
+namespace {
+    // stores the full 128-bit product of a and b in high and low
+    void multiplyWide(std::uint64_t a, std::uint64_t b,
+                      std::uint64_t& high, std::uint64_t& low)
+    {
+#ifdef __SIZEOF_INT128__
+        const auto product = static_cast<unsigned __int128>(a) * b;
+        high = static_cast<std::uint64_t>(product >> 64);
+        low = static_cast<std::uint64_t>(product);
+#else
+        const std::uint64_t mask {0xFFFF'FFFF};
+        const std::uint64_t aL = a & mask, aH = a >> 32, bL = b & mask, bH = b >> 32;
+        const std::uint64_t ll = aL * bL, lh = aL * bH, hl = aH * bL, hh = aH * bH;
+        const std::uint64_t middle = (ll >> 32) + (lh & mask) + (hl & mask);
+        high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+        low = (middle << 32) | (ll & mask);
+#endif
+    }
+
+    /*
+     * Left-to-right binary exponentiation over the bits of exp, stored as 32-bit words
+     * with the least significant word first. Leading zero bits are skipped so that no
+     * squaring is wasted on the identity.
+     */
+    template <typename T, typename Multiply>
+    T binaryPow(T one, const T& base, const std::vector<std::uint32_t>& exp,
+                Multiply mul)
+    {
+        T result {one};
+        bool started {};
+        for (std::size_t i = exp.size(); i--;) {
+            for (int bit {31}; bit >= 0; --bit) {
+                if (started)
+                    result = mul(result, result);
+                if ((exp[i] >> bit) & 1) {
+                    result = started ? mul(result, base) : base;
+                    started = true;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<std::uint32_t> toWords(unsigned long long exp)
+    {
+        return {static_cast<std::uint32_t>(exp), static_cast<std::uint32_t>(exp >> 32)};
+    }
+}
+
+MontgomeryContext<std::uint64_t>::MontgomeryContext(std::uint64_t modulus)
+    : m_modulus {modulus}
+{
+    if (!(modulus & 1))
+        throw std::invalid_argument("Montgomery modulus must be odd");
+
+    // Newton's iteration doubles the correct low bits of N^-1 each step, starting
+    // from N itself, which is its own inverse mod 2^3
+    m_inverse = modulus;
+    for (int i {0}; i < 5; ++i) {
+        m_inverse *= 2 - modulus * m_inverse;
+    }
+
+    // R mod N, then doubled 64 times to give R^2 mod N without overflowing
+    std::uint64_t r = (0 - modulus) % modulus;
+    for (int i {0}; i < 64; ++i) {
+        r = r >= modulus - r ? r - (modulus - r) : r + r;
+    }
+    m_rSquared = r;
+}
+
+/*
+ * Reduces T = high * 2^64 + low, with high < N, to T * R^-1 mod N.
+ *
+ * Subtracting m * N, where m = low * N^-1 mod 2^64, clears the low word exactly, so
+ * only the high words need to be subtracted.
+ */
+std::uint64_t MontgomeryContext<std::uint64_t>::reduce(std::uint64_t high,
+                                                       std::uint64_t low) const
+{
+    const std::uint64_t m = low * m_inverse;
+    std::uint64_t mHigh, mLow;
+    multiplyWide(m, m_modulus, mHigh, mLow);
+
+    return high < mHigh ? high - mHigh + m_modulus : high - mHigh;
+}
+
+std::uint64_t MontgomeryContext<std::uint64_t>::toMontgomery(std::uint64_t x) const
+{
+    return mulmod(x % m_modulus, m_rSquared);
+}
+
+std::uint64_t MontgomeryContext<std::uint64_t>::mulmod(std::uint64_t a,
+                                                       std::uint64_t b) const
+{
+    std::uint64_t high, low;
+    multiplyWide(a, b, high, low);
+
+    return reduce(high, low);
+}
+
+std::uint64_t MontgomeryContext<std::uint64_t>::powmod(std::uint64_t base,
+                                                       std::uint64_t exp) const
+{
+    const auto result = binaryPow(
+            toMontgomery(1), toMontgomery(base), toWords(exp),
+            [this](std::uint64_t a, std::uint64_t b) { return mulmod(a, b); }
+    );
+
+    return fromMontgomery(result);
+}
+
+MontgomeryContext<BigInt>::MontgomeryContext(const BigInt& modulus)
+    : m_modulus {modulus}
+{
+    const BigInt::LimbView limbs {modulus};
+    const auto low = limbs[0];
+    if (!(low & 1) || !(low % 5))
+        throw std::invalid_argument("Montgomery modulus must be coprime to 10");
+
+    // extended Euclidean algorithm for N^-1 mod 1e9
+    std::int64_t r0 {BigInt::BASE}, r1 {low}, t0 {0}, t1 {1};
+    while (r1) {
+        const auto q = r0 / r1;
+        r0 -= q * r1;
+        std::swap(r0, r1);
+        t0 -= q * t1;
+        std::swap(t0, t1);
+    }
+    if (t0 < 0)
+        t0 += BigInt::BASE;
+    m_inverse = t0 ? BigInt::BASE - t0 : 0;
+
+    const auto k = limbs.size;
+    BigInt r;
+    r.m_limbs.assign(k, 0);
+    r.m_limbs.push_back(1);
+    m_one = r % modulus;
+    r.m_limbs.assign(2 * k, 0);
+    r.m_limbs.push_back(1);
+    m_rSquared = r % modulus;
+}
+
+/*
+ * Reduces x < N * R to x * R^-1 mod N, by adding the multiple of N that clears each
+ * of the k lowest limbs in turn, then shifting them out.
+ */
+BigInt MontgomeryContext<BigInt>::reduce(const BigInt& x) const
+{
+    const BigInt::LimbView n {m_modulus}, xV {x};
+    const auto k = n.size;
+    std::vector<std::uint32_t> t(xV.data, xV.data + xV.size);
+    t.resize(std::max(t.size(), 2 * k) + 1, 0);
+
+    for (std::size_t i {0}; i < k; ++i) {
+        const auto m = static_cast<std::uint32_t>(
+                1uLL * t[i] * m_inverse % BigInt::BASE
+        );
+        std::uint64_t carry {};
+        for (std::size_t j {0}; j < k; ++j) {
+            const auto current = t[i + j] + 1uLL * m * n[j] + carry;
+            t[i + j] = current % BigInt::BASE;
+            carry = current / BigInt::BASE;
+        }
+        for (auto j = i + k; carry; ++j) {
+            const auto current = t[j] + carry;
+            t[j] = current % BigInt::BASE;
+            carry = current / BigInt::BASE;
+        }
+    }
+
+    BigInt result {BigInt::Limbs(t.cbegin() + k, t.cend())};
+    if (result >= m_modulus)
+        result -= m_modulus;
+
+    return result;
+}
+
+BigInt MontgomeryContext<BigInt>::toMontgomery(const BigInt& x) const
+{
+    return reduce(x % m_modulus * m_rSquared);
+}
+
+BigInt MontgomeryContext<BigInt>::mulmod(const BigInt& a, const BigInt& b) const
+{
+    return reduce(a * b);
+}
+
+BigInt MontgomeryContext<BigInt>::powmod(const BigInt& base,
+                                         const std::vector<std::uint32_t>& exp) const
+{
+    const auto result = binaryPow(
+            m_one, toMontgomery(base), exp,
+            [this](const BigInt& a, const BigInt& b) { return mulmod(a, b); }
+    );
+
+    return fromMontgomery(result);
+}
+
+BigInt MontgomeryContext<BigInt>::powmod(const BigInt& base,
+                                         unsigned long long exp) const
+{
+    return powmod(base, toWords(exp));
+}
+
+BigInt MontgomeryContext<BigInt>::powmod(const BigInt& base, const BigInt& exp) const
+{
+    // the exponent is converted to binary once, instead of being halved every step
+    std::vector<std::uint32_t> words;
+    BigInt remaining {exp};
+    do {
+        auto [quotient, word] = divmod(remaining, 1uLL << 32);
+        words.push_back(static_cast<std::uint32_t>(word));
+        remaining = quotient;
+    } while (!remaining.isZero());
+
+    return powmod(base, words);
+}
+
+TEST_SUITE("test MontgomeryContext") {
+    TEST_CASE("word context when modulus is even") {
+        CHECK_THROWS_AS(MontgomeryContext<std::uint64_t> {0}, std::invalid_argument);
+        CHECK_THROWS_AS(MontgomeryContext<std::uint64_t> {1000}, std::invalid_argument);
+    }
+
+    TEST_CASE("word context round trip") {
+        const MontgomeryContext<std::uint64_t> context {1'000'000'007};
+
+        for (std::uint64_t x : {0uLL, 1uLL, 2uLL, 999'999'999uLL, 1'000'000'006uLL}) {
+            CHECK_EQ(x, context.fromMontgomery(context.toMontgomery(x)));
+        }
+        CHECK_EQ(3, context.fromMontgomery(context.toMontgomery(1'000'000'010)));
+    }
+
+    TEST_CASE("word context mulmod()") {
+        const std::uint64_t modulus {18'446'744'073'709'551'557uLL};
+        const MontgomeryContext<std::uint64_t> context {modulus};
+        const std::uint64_t a {12'345'678'901'234'567'890uLL}, b {9'876'543'210'987uLL};
+        const auto product = context.mulmod(context.toMontgomery(a),
+                                            context.toMontgomery(b));
+        const BigInt expected = BigInt {a} * BigInt {b} % BigInt {modulus};
+
+        CHECK_EQ(expected.toULLong(), context.fromMontgomery(product));
+    }
+
+    TEST_CASE("word context powmod()") {
+        const MontgomeryContext<std::uint64_t> seven {7};
+        const std::uint64_t expected[] {1, 3, 2, 6, 4, 5, 1};
+        for (std::uint64_t k {0}; k < 7; ++k) {
+            CHECK_EQ(expected[k], seven.powmod(10, k));
+        }
+
+        CHECK_EQ(0, MontgomeryContext<std::uint64_t> {1}.powmod(10, 5));
+        // Fermat's little theorem for the largest prime below 2^64
+        const std::uint64_t prime {18'446'744'073'709'551'557uLL};
+        const MontgomeryContext<std::uint64_t> context {prime};
+        CHECK_EQ(1, context.powmod(3, prime - 1));
+        CHECK_EQ(prime - 1, context.powmod(prime - 1, prime - 2));
+    }
+
+    TEST_CASE("BigInt context when modulus shares a factor with 10") {
+        CHECK_THROWS_AS(MontgomeryContext<BigInt> {BigInt {"1000000000000"}},
+                        std::invalid_argument);
+        CHECK_THROWS_AS(MontgomeryContext<BigInt> {BigInt {"1234567890123455"}},
+                        std::invalid_argument);
+    }
+
+    TEST_CASE("BigInt context round trip and mulmod()") {
+        const BigInt modulus {"170141183460469231731687303715884105727"};
+        const MontgomeryContext<BigInt> context {modulus};
+        const BigInt a {"98765432109876543210987654321"}, b {"123456789123456789123"};
+
+        CHECK_EQ(a, context.fromMontgomery(context.toMontgomery(a)));
+        CHECK_EQ(a * b % modulus, context.fromMontgomery(
+                context.mulmod(context.toMontgomery(a), context.toMontgomery(b))
+        ));
+    }
+
+    TEST_CASE("BigInt context powmod()") {
+        // Mersenne prime 2^127 - 1
+        const BigInt prime {"170141183460469231731687303715884105727"};
+        const MontgomeryContext<BigInt> context {prime};
+
+        CHECK_EQ(BigInt::one(), context.powmod(BigInt {3uLL}, prime - BigInt::one()));
+        CHECK_EQ(BigInt::one(), context.powmod(BigInt {2uLL}, 127uLL));
+        CHECK_EQ(BigInt::one(), context.powmod(BigInt {5uLL}, 0uLL));
+
+        const BigInt modulus {"1000000000000000000000000000000000000007"};
+        const MontgomeryContext<BigInt> other {modulus};
+        const BigInt base {"31415926535897932384626433832795028841971"};
+        const BigInt exp {"27182818284590452353602874713527"};
+        CHECK_EQ(base.modPow(exp, modulus), other.powmod(base, exp));
+    }
+}
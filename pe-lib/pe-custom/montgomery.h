@@ -0,0 +1,94 @@
+#ifndef PROJECT_EULER_CPP_MONTGOMERY_H
+#define PROJECT_EULER_CPP_MONTGOMERY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "big-int.h"
+
+/*
+ * Context for repeated modular arithmetic with a fixed modulus N, using Montgomery
+ * reduction so that no division is performed once the context has been built.
+ *
+ * Values are kept in Montgomery form, x * R mod N, where R is a power of the storage
+ * base that exceeds N. Reducing a product then only needs multiplications, additions
+ * and a shift by whole words. R and N' = -N^-1 mod base are precomputed on
+ * construction.
+ *
+ * Specialisations exist for moduli that fit in 64 bits and for BigInt moduli.
+ */
+template <typename T>
+class MontgomeryContext;
+
+/*
+ * Word-size context, with R = 2^64.
+ *
+ * @throws std::invalid_argument if the modulus is even.
+ */
+template <>
+class MontgomeryContext<std::uint64_t> {
+public:
+    explicit MontgomeryContext(std::uint64_t modulus);
+
+    std::uint64_t modulus() const { return m_modulus; }
+
+    std::uint64_t toMontgomery(std::uint64_t x) const;
+    std::uint64_t fromMontgomery(std::uint64_t x) const { return reduce(0, x); }
+
+    /*
+     * @return product of 2 values already in Montgomery form, also in Montgomery form.
+     */
+    std::uint64_t mulmod(std::uint64_t a, std::uint64_t b) const;
+    /*
+     * @return base^exp mod N, with both base and result in normal form.
+     */
+    std::uint64_t powmod(std::uint64_t base, std::uint64_t exp) const;
+
+private:
+    std::uint64_t m_modulus;
+    // N^-1 mod 2^64, so that reduction subtracts instead of adds
+    std::uint64_t m_inverse {};
+    // R^2 mod N, used to convert values to Montgomery form
+    std::uint64_t m_rSquared {};
+
+    std::uint64_t reduce(std::uint64_t high, std::uint64_t low) const;
+};
+
+/*
+ * BigInt context, with R = 1e9^k for a modulus of k limbs, so that reduction works
+ * directly on the limbs of BigInt.
+ *
+ * @throws std::invalid_argument if the modulus shares a factor with 10.
+ */
+template <>
+class MontgomeryContext<BigInt> {
+public:
+    explicit MontgomeryContext(const BigInt& modulus);
+
+    const BigInt& modulus() const { return m_modulus; }
+
+    BigInt toMontgomery(const BigInt& x) const;
+    BigInt fromMontgomery(const BigInt& x) const { return reduce(x); }
+
+    /*
+     * @return product of 2 values already in Montgomery form, also in Montgomery form.
+     */
+    BigInt mulmod(const BigInt& a, const BigInt& b) const;
+    /*
+     * @return base^exp mod N, with both base and result in normal form.
+     */
+    BigInt powmod(const BigInt& base, unsigned long long exp) const;
+    BigInt powmod(const BigInt& base, const BigInt& exp) const;
+
+private:
+    BigInt m_modulus;
+    // -N^-1 mod 1e9
+    std::uint32_t m_inverse {};
+    BigInt m_rSquared;
+    BigInt m_one;
+
+    BigInt reduce(const BigInt& x) const;
+    BigInt powmod(const BigInt& base, const std::vector<std::uint32_t>& exp) const;
+};
+
+#endif //PROJECT_EULER_CPP_MONTGOMERY_H
@@ -0,0 +1,119 @@
+#include "uint.h"
+
+#include <random>
+
+#include "../../doctest/doctest.h"
+
+TEST_SUITE("test UInt") {
+    TEST_CASE("constexpr arithmetic") {
+        constexpr UInt<128> max64 {UINT64_MAX};
+        constexpr auto square = max64 * max64;
+        static_assert(square.word(0) == 1 && square.word(1) == UINT64_MAX - 1);
+        static_assert(square / max64 == max64 && square % max64 == 0);
+        static_assert((max64 + 1).bitLength() == 65);
+        static_assert(UInt<256> {3}.pow(100) / UInt<256> {3}.pow(99) == 3);
+
+        CHECK_EQ(UInt<128> {"340282366920938463426481119284349108225"}, square);
+    }
+
+    TEST_CASE("constructors and toString()") {
+        CHECK_EQ("0", UInt<128> {}.toString());
+        CHECK_EQ("18446744073709551615", UInt<128> {UINT64_MAX}.toString());
+        CHECK_EQ("10000000000000000000", UInt<128> {"10000000000000000000"}.toString());
+        const std::string max128 {"340282366920938463463374607431768211455"};
+        CHECK_EQ(max128, UInt<128> {max128}.toString());
+        CHECK_EQ(max128, UInt<256> {"000" + max128}.toString());
+
+        CHECK_THROWS_AS(UInt<128> {""}, std::invalid_argument);
+        CHECK_THROWS_AS(UInt<128> {"12a"}, std::invalid_argument);
+        CHECK_THROWS_AS(UInt<128> {"340282366920938463463374607431768211456"},
+                        std::out_of_range);
+    }
+
+    TEST_CASE("conversion to and from BigInt") {
+        const BigInt big {"123456789012345678901234567890123456789012345678901234567890"};
+        const UInt<256> value {big};
+
+        CHECK_EQ(big.toString(), value.toString());
+        CHECK_EQ(big, value.toBigInt());
+        CHECK_EQ(BigInt::zero(), UInt<128> {}.toBigInt());
+        CHECK_EQ(BigInt {42uLL}, UInt<128> {BigInt {42uLL}}.toBigInt());
+        CHECK_THROWS_AS(UInt<128> {big}, std::out_of_range);
+        CHECK_EQ(42, UInt<128> {42}.toULLong());
+        CHECK_THROWS_AS(value.toULLong(), std::out_of_range);
+    }
+
+    TEST_CASE("results wrap around like native unsigned types") {
+        const UInt<128> zero, max = zero - 1;
+
+        CHECK_EQ("340282366920938463463374607431768211455", max.toString());
+        CHECK_EQ(zero, max + 1);
+        CHECK_EQ(max - 1, max * max * (max - 1));
+        CHECK_EQ(UInt<128> {"340282366920938463463374607431768211454"}, max << 1);
+        CHECK_EQ(UInt<128> {1} << 127, (max >> 127) << 127);
+        CHECK_EQ(zero, max << 128);
+        CHECK_EQ(UInt<256> {1} << 128, UInt<256> {max} + 1);
+        // (2^128 - 1)^2 = 2^256 - 2^129 + 1
+        CHECK_EQ(UInt<128> {1}, UInt<128> {UInt<256> {max} * UInt<256> {max}});
+    }
+
+    TEST_CASE("mulWide() keeps the full product") {
+        const UInt<128> max = UInt<128> {} - 1;
+        const auto product = max.mulWide(max);
+
+        CHECK_EQ(256, product.bitLength());
+        CHECK_EQ(max.toBigInt() * max.toBigInt(), product.toBigInt());
+    }
+
+    TEST_CASE("division") {
+        CHECK_THROWS_AS(UInt<128> {5} / UInt<128> {}, std::runtime_error);
+        CHECK_EQ(0, UInt<128> {5} / UInt<128> {6});
+        CHECK_EQ(5, UInt<128> {5} % UInt<128> {6});
+
+        const UInt<256> a {"115792089237316195423570985008687907853269984665640564039457"};
+        const UInt<256> b {"340282366920938463463374607431768211297"};
+        const auto [quotient, remainder] = divmod(a, b);
+        CHECK_EQ(a, quotient * b + remainder);
+        CHECK_LT(remainder, b);
+    }
+
+    TEST_CASE("arithmetic agrees with BigInt") {
+        std::mt19937_64 generator {16};
+        // words near 0 & 2^64 make carries, borrows and quotient corrections likely
+        const std::uint64_t specials[] {0, 1, UINT64_MAX, UINT64_MAX - 1, 1uLL << 63};
+        auto randomUInt = [&](std::size_t words) {
+            UInt<512> value;
+            for (std::size_t i {0}; i < words; ++i) {
+                const auto word = generator() % 4 ? generator() : specials[generator() % 5];
+                value = (value << 64) + word;
+            }
+            return value;
+        };
+        const auto modulus = BigInt {2uLL}.pow(512uLL);
+
+        for (int round {0}; round < 500; ++round) {
+            const auto a = randomUInt(1 + generator() % 8);
+            const auto b = randomUInt(1 + generator() % 8);
+            const auto bigA = a.toBigInt(), bigB = b.toBigInt();
+
+            CHECK_EQ((bigA + bigB) % modulus, (a + b).toBigInt());
+            CHECK_EQ(bigA * bigB % modulus, (a * b).toBigInt());
+            CHECK_EQ(bigA * bigB, a.mulWide(b).toBigInt());
+            if (bigA >= bigB)
+                CHECK_EQ(bigA - bigB, (a - b).toBigInt());
+            if (b != 0) {
+                const auto [quotient, remainder] = divmod(a, b);
+                CHECK_EQ(bigA / bigB, quotient.toBigInt());
+                CHECK_EQ(bigA % bigB, remainder.toBigInt());
+            }
+        }
+    }
+
+    TEST_CASE("pow()") {
+        CHECK_EQ(1, UInt<128> {0}.pow(0));
+        CHECK_EQ(0, UInt<128> {0}.pow(5));
+        CHECK_EQ(UInt<128> {1} << 127, UInt<128> {2}.pow(127));
+        CHECK_EQ(0, UInt<128> {2}.pow(128));
+        CHECK_EQ(BigInt {7uLL}.pow(90uLL), UInt<256> {7}.pow(90).toBigInt());
+    }
+}
@@ -0,0 +1,503 @@
+#ifndef PROJECT_EULER_CPP_UINT_H
+#define PROJECT_EULER_CPP_UINT_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "big-int.h"
+
+namespace uint_detail {
+    constexpr int countLeadingZeros(std::uint64_t x)
+    {
+#if defined(__GNUC__)
+        return x ? __builtin_clzll(x) : 64;
+#else
+        int count {};
+        for (std::uint64_t bit {1uLL << 63}; bit && !(x & bit); bit >>= 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    /*
+     * @return low word of a * b + c + d, with the high word stored in high. The result
+     * can never overflow 128 bits.
+     */
+    constexpr std::uint64_t mulAdd(std::uint64_t a, std::uint64_t b, std::uint64_t c,
+                                   std::uint64_t d, std::uint64_t& high)
+    {
+#ifdef __SIZEOF_INT128__
+        const auto full = static_cast<unsigned __int128>(a) * b + c + d;
+        high = static_cast<std::uint64_t>(full >> 64);
+        return static_cast<std::uint64_t>(full);
+#else
+        const std::uint64_t mask {0xFFFF'FFFF};
+        const std::uint64_t aL = a & mask, aH = a >> 32, bL = b & mask, bH = b >> 32;
+        const std::uint64_t ll = aL * bL, lh = aL * bH, hl = aH * bL, hh = aH * bH;
+        const std::uint64_t middle = (ll >> 32) + (lh & mask) + (hl & mask);
+        high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+        std::uint64_t low = (middle << 32) | (ll & mask);
+        low += c;
+        high += low < c;
+        low += d;
+        high += low < d;
+        return low;
+#endif
+    }
+
+    /*
+     * @return quotient of (high * 2^64 + low) / d, with the remainder stored in
+     * remainder. The quotient fits in a word as long as high < d.
+     */
+    constexpr std::uint64_t divWide(std::uint64_t high, std::uint64_t low, std::uint64_t d,
+                                    std::uint64_t& remainder)
+    {
+#ifdef __SIZEOF_INT128__
+        const auto n = static_cast<unsigned __int128>(high) << 64 | low;
+        remainder = static_cast<std::uint64_t>(n % d);
+        return static_cast<std::uint64_t>(n / d);
+#else
+        // restoring division, 1 bit of the quotient per step
+        std::uint64_t quotient {};
+        for (int i {63}; i >= 0; --i) {
+            const bool top = high >> 63;
+            high = high << 1 | (low >> i & 1);
+            quotient <<= 1;
+            if (top || high >= d) {
+                high -= d;
+                quotient |= 1;
+            }
+        }
+        remainder = high;
+        return quotient;
+#endif
+    }
+}
+
+/*
+ * Unsigned integer of a fixed width of Bits, for values that overflow unsigned long long
+ * but have a known bound of a few hundred bits.
+ *
+ * Values are stored as 64-bit words on the stack, with the least significant word first,
+ * so no operation allocates and all arithmetic is constexpr. As with native unsigned
+ * types, every result wraps around modulo 2^Bits, unless mulWide() is used to keep the
+ * full product.
+ *
+ * Products & quotients of 128 bits use unsigned __int128 where the compiler supports it,
+ * with portable fallbacks otherwise.
+ */
+template <std::size_t Bits>
+class UInt {
+    static_assert(Bits >= 128 && Bits % 64 == 0,
+                  "UInt width must be a multiple of 64 bits, of at least 128 bits");
+
+public:
+    static constexpr std::size_t WORDS {Bits / 64};
+
+    constexpr UInt() = default;
+    // implicit, as for widening conversions between native unsigned types
+    constexpr UInt(unsigned long long value) : m_words {value} {}
+    // converts between widths, keeping only the low Bits bits when narrowing
+    template <std::size_t Other>
+    explicit constexpr UInt(const UInt<Other>& value)
+    {
+        for (std::size_t i {0}; i < std::min(WORDS, UInt<Other>::WORDS); ++i) {
+            m_words[i] = value.m_words[i];
+        }
+    }
+    /*
+     * @throws std::invalid_argument if the string is empty or contains non-digits.
+     * @throws std::out_of_range if the value needs more than Bits bits.
+     */
+    explicit UInt(const std::string& value)
+    {
+        if (value.empty())
+            throw std::invalid_argument("String must represent a number");
+        for (const auto& ch : value) {
+            if (!isdigit(ch))
+                throw std::invalid_argument("String must represent a number");
+        }
+
+        // up to 19 digits at a time fit in a word
+        for (std::size_t start {0}; start < value.size(); start += 19) {
+            const auto end = std::min(value.size(), start + 19);
+            std::uint64_t chunk {}, scale {1};
+            for (auto i = start; i < end; ++i) {
+                chunk = chunk * 10 + (value[i] - '0');
+                scale *= 10;
+            }
+            if (mulAddWord(scale, chunk))
+                throw std::out_of_range("Value exceeds UInt range");
+        }
+    }
+    /*
+     * @throws std::out_of_range if the value needs more than Bits bits.
+     */
+    explicit UInt(const BigInt& value)
+    {
+        const BigInt::LimbView limbs {value};
+        for (std::size_t i = limbs.size; i--;) {
+            if (mulAddWord(BigInt::BASE, limbs[i]))
+                throw std::out_of_range("Value exceeds UInt range");
+        }
+    }
+
+    constexpr std::uint64_t word(std::size_t i) const { return m_words[i]; }
+
+    /*
+     * @return amount of bits needed to represent this number, which is 0 for zero.
+     */
+    constexpr std::size_t bitLength() const
+    {
+        for (std::size_t i = WORDS; i--;) {
+            if (m_words[i])
+                return 64 * i + 64 - uint_detail::countLeadingZeros(m_words[i]);
+        }
+
+        return 0;
+    }
+
+    friend constexpr bool operator==(const UInt& a, const UInt& b)
+    {
+        for (std::size_t i {0}; i < WORDS; ++i) {
+            if (a.m_words[i] != b.m_words[i])
+                return false;
+        }
+
+        return true;
+    }
+    friend constexpr bool operator!=(const UInt& a, const UInt& b) { return !(a == b); }
+    friend constexpr bool operator<(const UInt& a, const UInt& b)
+    {
+        for (std::size_t i = WORDS; i--;) {
+            if (a.m_words[i] != b.m_words[i])
+                return a.m_words[i] < b.m_words[i];
+        }
+
+        return false;
+    }
+    friend constexpr bool operator>(const UInt& a, const UInt& b) { return b < a; }
+    friend constexpr bool operator<=(const UInt& a, const UInt& b) { return !(b < a); }
+    friend constexpr bool operator>=(const UInt& a, const UInt& b) { return !(a < b); }
+
+    constexpr UInt& operator++() { return *this += 1; }
+    constexpr UInt& operator--() { return *this -= 1; }
+
+    friend constexpr UInt& operator+=(UInt& a, const UInt& b)
+    {
+        std::uint64_t carry {};
+        for (std::size_t i {0}; i < WORDS; ++i) {
+            const auto sum = a.m_words[i] + carry;
+            carry = sum < carry;
+            a.m_words[i] = sum + b.m_words[i];
+            carry += a.m_words[i] < sum;
+        }
+
+        return a;
+    }
+    friend constexpr UInt operator+(UInt a, const UInt& b) { return a += b; }
+    friend constexpr UInt& operator-=(UInt& a, const UInt& b)
+    {
+        std::uint64_t borrow {};
+        for (std::size_t i {0}; i < WORDS; ++i) {
+            const auto sub = b.m_words[i] + borrow;
+            borrow = sub < borrow || a.m_words[i] < sub;
+            a.m_words[i] -= sub;
+        }
+
+        return a;
+    }
+    friend constexpr UInt operator-(UInt a, const UInt& b) { return a -= b; }
+
+    /*
+     * Schoolbook multiplication that skips every word product beyond the width, so
+     * costs about half of the full product.
+     */
+    friend constexpr UInt operator*(const UInt& a, const UInt& b)
+    {
+        UInt product;
+        for (std::size_t i {0}; i < WORDS; ++i) {
+            if (!a.m_words[i])
+                continue;
+            std::uint64_t carry {};
+            for (std::size_t j {0}; i + j < WORDS; ++j) {
+                std::uint64_t high {};
+                product.m_words[i+j] = uint_detail::mulAdd(
+                        a.m_words[i], b.m_words[j], product.m_words[i+j], carry, high);
+                carry = high;
+            }
+        }
+
+        return product;
+    }
+    friend constexpr UInt& operator*=(UInt& a, const UInt& b) { return a = a * b; }
+
+    /*
+     * @return the full product of this number and b, which never wraps around.
+     */
+    constexpr UInt<2 * Bits> mulWide(const UInt& b) const
+    {
+        UInt<2 * Bits> product;
+        for (std::size_t i {0}; i < WORDS; ++i) {
+            std::uint64_t carry {};
+            for (std::size_t j {0}; j < WORDS; ++j) {
+                std::uint64_t high {};
+                product.m_words[i+j] = uint_detail::mulAdd(
+                        m_words[i], b.m_words[j], product.m_words[i+j], carry, high);
+                carry = high;
+            }
+            product.m_words[i+WORDS] = carry;
+        }
+
+        return product;
+    }
+
+    /*
+     * Long division based on Knuth's Algorithm D (TAOCP Vol. 2, 4.3.1), using words as
+     * digits in base 2^64, as also done by BigInt in base 1e9. A single-word divisor
+     * only needs 1 wide division per word of the dividend.
+     *
+     * @return pair of {quotient, remainder}.
+     * @throws std::runtime_error if b = 0.
+     */
+    friend constexpr std::pair<UInt, UInt> divmod(const UInt& a, const UInt& b)
+    {
+        const auto n = b.significantWords();
+        if (!n)
+            throw std::runtime_error("Division by zero");
+        if (a < b)
+            return {UInt {}, a};
+
+        UInt quotient;
+        if (n == 1) {
+            std::uint64_t remainder {};
+            for (std::size_t i = a.significantWords(); i--;) {
+                quotient.m_words[i] = uint_detail::divWide(
+                        remainder, a.m_words[i], b.m_words[0], remainder);
+            }
+            return {quotient, UInt {remainder}};
+        }
+
+        // normalising makes the top word of the divisor at least 2^63, so that every
+        // quotient word estimate is at most 2 too large
+        const auto shift = uint_detail::countLeadingZeros(b.m_words[n-1]);
+        const auto m = a.significantWords();
+        std::uint64_t u[WORDS+1] {}, v[WORDS] {};
+        for (std::size_t i {0}; i < m; ++i) {
+            u[i] |= a.m_words[i] << shift;
+            if (shift)
+                u[i+1] = a.m_words[i] >> (64 - shift);
+        }
+        for (std::size_t i {0}; i < n; ++i) {
+            v[i] = b.m_words[i] << shift;
+            if (shift && i)
+                v[i] |= b.m_words[i-1] >> (64 - shift);
+        }
+
+        for (std::size_t j = m - n + 1; j--;) {
+            std::uint64_t qHat {}, rHat {};
+            bool rHatOverflow {};
+            if (u[j+n] >= v[n-1]) {
+                qHat = ~std::uint64_t {};
+                rHat = u[j+n-1] + v[n-1];
+                rHatOverflow = rHat < v[n-1];
+            }
+            else {
+                qHat = uint_detail::divWide(u[j+n], u[j+n-1], v[n-1], rHat);
+            }
+            while (!rHatOverflow) {
+                std::uint64_t high {};
+                const auto low = uint_detail::mulAdd(qHat, v[n-2], 0, 0, high);
+                if (high < rHat || (high == rHat && low <= u[j+n-2]))
+                    break;
+                qHat--;
+                rHat += v[n-1];
+                rHatOverflow = rHat < v[n-1];
+            }
+
+            std::uint64_t carry {}, borrow {};
+            for (std::size_t i {0}; i < n; ++i) {
+                std::uint64_t high {};
+                const auto product = uint_detail::mulAdd(qHat, v[i], carry, 0, high);
+                carry = high;
+                const auto sub = u[i+j] - product;
+                const bool under = u[i+j] < product;
+                u[i+j] = sub - borrow;
+                borrow = under || sub < borrow;
+            }
+            const auto top = u[j+n];
+            u[j+n] = top - carry - borrow;
+            if (top < carry || top - carry < borrow) {
+                // estimate was still 1 too large, so the divisor is added back once
+                qHat--;
+                std::uint64_t addCarry {};
+                for (std::size_t i {0}; i < n; ++i) {
+                    const auto sum = u[i+j] + addCarry;
+                    addCarry = sum < addCarry;
+                    u[i+j] = sum + v[i];
+                    addCarry += u[i+j] < sum;
+                }
+                u[j+n] += addCarry;
+            }
+            quotient.m_words[j] = qHat;
+        }
+
+        UInt remainder;
+        for (std::size_t i {0}; i < n; ++i) {
+            remainder.m_words[i] = u[i] >> shift;
+            if (shift)
+                remainder.m_words[i] |= u[i+1] << (64 - shift);
+        }
+
+        return {quotient, remainder};
+    }
+    friend constexpr UInt operator/(const UInt& a, const UInt& b)
+    {
+        return divmod(a, b).first;
+    }
+    friend constexpr UInt& operator/=(UInt& a, const UInt& b) { return a = a / b; }
+    friend constexpr UInt operator%(const UInt& a, const UInt& b)
+    {
+        return divmod(a, b).second;
+    }
+    friend constexpr UInt& operator%=(UInt& a, const UInt& b) { return a = a % b; }
+
+    friend constexpr UInt& operator<<=(UInt& a, std::size_t shift)
+    {
+        const auto words = shift / 64, bits = shift % 64;
+        for (std::size_t i = WORDS; i--;) {
+            std::uint64_t word {};
+            if (i >= words) {
+                word = a.m_words[i-words] << bits;
+                if (bits && i > words)
+                    word |= a.m_words[i-words-1] >> (64 - bits);
+            }
+            a.m_words[i] = word;
+        }
+
+        return a;
+    }
+    friend constexpr UInt operator<<(UInt a, std::size_t shift) { return a <<= shift; }
+    friend constexpr UInt& operator>>=(UInt& a, std::size_t shift)
+    {
+        const auto words = shift / 64, bits = shift % 64;
+        for (std::size_t i {0}; i < WORDS; ++i) {
+            std::uint64_t word {};
+            if (i + words < WORDS) {
+                word = a.m_words[i+words] >> bits;
+                if (bits && i + words + 1 < WORDS)
+                    word |= a.m_words[i+words+1] << (64 - bits);
+            }
+            a.m_words[i] = word;
+        }
+
+        return a;
+    }
+    friend constexpr UInt operator>>(UInt a, std::size_t shift) { return a >>= shift; }
+
+    /*
+     * @return this number raised to exp, modulo 2^Bits like every other result.
+     */
+    constexpr UInt pow(unsigned long long exp) const
+    {
+        UInt base {*this}, result {1};
+        for (; exp; exp >>= 1) {
+            if (exp & 1)
+                result *= base;
+            if (exp > 1)
+                base *= base;
+        }
+
+        return result;
+    }
+
+    /*
+     * Splits off 19 digits at a time, as 1e19 is the largest power of 10 that fits in
+     * a word.
+     */
+    std::string toString() const
+    {
+        constexpr std::uint64_t chunkBase {10'000'000'000'000'000'000uLL};
+        std::vector<std::uint64_t> chunks;
+        UInt value {*this};
+        do {
+            chunks.push_back(value.divideWord(chunkBase));
+        } while (value.significantWords());
+
+        std::string result = std::to_string(chunks.back());
+        for (std::size_t i = chunks.size() - 1; i--;) {
+            const auto chunk = std::to_string(chunks[i]);
+            result.append(19 - chunk.size(), '0').append(chunk);
+        }
+
+        return result;
+    }
+
+    BigInt toBigInt() const
+    {
+        BigInt::Limbs limbs;
+        UInt value {*this};
+        do {
+            limbs.push_back(static_cast<std::uint32_t>(value.divideWord(BigInt::BASE)));
+        } while (value.significantWords());
+
+        return BigInt {std::move(limbs)};
+    }
+
+    /*
+     * @throws std::out_of_range if converted value would overflow unsigned long long
+     * range.
+     */
+    unsigned long long toULLong() const
+    {
+        if (significantWords() > 1)
+            throw std::out_of_range("UInt exceeds unsigned long long range");
+
+        return m_words[0];
+    }
+
+private:
+    template <std::size_t>
+    friend class UInt;
+
+    std::uint64_t m_words[WORDS] {};
+
+    constexpr std::size_t significantWords() const
+    {
+        auto size = WORDS;
+        while (size && !m_words[size-1]) {
+            size--;
+        }
+
+        return size;
+    }
+
+    // replaces this number with this * m + w, @return the word that overflowed
+    constexpr std::uint64_t mulAddWord(std::uint64_t m, std::uint64_t w)
+    {
+        for (auto& word : m_words) {
+            word = uint_detail::mulAdd(word, m, w, 0, w);
+        }
+
+        return w;
+    }
+
+    // divides this number in place by d, @return the remainder
+    constexpr std::uint64_t divideWord(std::uint64_t d)
+    {
+        std::uint64_t remainder {};
+        for (std::size_t i = WORDS; i--;) {
+            m_words[i] = uint_detail::divWide(remainder, m_words[i], d, remainder);
+        }
+
+        return remainder;
+    }
+};
+
+#endif //PROJECT_EULER_CPP_UINT_H
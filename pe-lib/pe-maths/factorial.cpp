@@ -1,23 +1,150 @@
 #include "factorial.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "primes.h"
+
 #include "../../doctest/doctest.h"
 
 #include "../pe-custom/big-int.cpp"
+#include "../pe-tests/count-allocations.h"
 
 /*
- * Recursive solution uses custom BigInt class to handle overflow.
+ * Solution uses custom BigInt class to handle overflow.
  *
  * 13! overflows 32 bits and 21! overflows 64 bits and 59! produces a result that is
  * greater than 1e80 (postulated to be the number of particles in the universe).
+ *
+ * The original tail recursion, factorial(n - 1, run * n), is unrolled into a loop that
+ * multiplies a single running product in place by native words, so that no temporary
+ * BigInt is created per step. Consecutive factors are first packed into one word for as
+ * long as their product stays below 1e9, so that each pass over the product's limbs
+ * applies several factors at once.
+ *
+ * From primeLimit onwards, the product is instead built from its prime factorisation,
+ * as by Legendre's formula the exponent of every prime p <= n in n! is the sum of
+ * floor(n/p^i). Only log(n) squarings of balanced size are then performed by
+ * primePowerProduct(), instead of n - 1 growing multiplications by a small factor.
  */
 BigInt factorial(unsigned long n, const BigInt& run)
 {
     if (n == 0)
         return BigInt::one();
-    if (n == 1)
-        return run;
 
-    return factorial(n - 1, run * BigInt {n});
+    // based on timings of both methods, which are about even at 500!
+    const unsigned long primeLimit {500};
+    if (n < primeLimit) {
+        BigInt product {run};
+        unsigned long long factors {1};
+        for (; n > 1; --n) {
+            if (n >= 1'000'000'000 / factors) {
+                product *= factors;
+                factors = 1;
+            }
+            factors *= n;
+        }
+        product *= factors;
+
+        return product;
+    }
+
+    const auto primes = primeNumbers(n);
+    std::vector<unsigned long> exponents(primes.size());
+    for (std::size_t i {0}; i < primes.size(); ++i) {
+        for (auto q = n; q >= primes[i]; ) {
+            q /= primes[i];
+            exponents[i] += q;
+        }
+    }
+
+    return primePowerProduct(primes, exponents) * run;
+}
+
+/*
+ * The product is that over every bit b of (the product of all primes whose exponent has
+ * bit b set)^(2^b). This is evaluated from the highest bit down, squaring the result
+ * before multiplying in the primes of each bit, so every prime is multiplied in at most
+ * log(e) times & the squarings are the only multiplications of large operands.
+ */
+BigInt primePowerProduct(const std::vector<unsigned long>& primes,
+                         const std::vector<unsigned long>& exponents)
+{
+    if (primes.empty())
+        return BigInt::one();
+
+    const auto maxExponent = *std::max_element(exponents.cbegin(), exponents.cend());
+    int topBit {};
+    while (maxExponent >> (topBit + 1)) {
+        topBit++;
+    }
+    BigInt product {BigInt::one()};
+    std::vector<unsigned long long> words;
+    for (int bit {topBit}; bit >= 0; --bit) {
+        words.clear();
+        // primes are only multiplied by each other, so can fill a whole native word
+        unsigned long long factors {1};
+        for (std::size_t i {0}; i < primes.size(); ++i) {
+            if (!(exponents[i] >> bit & 1))
+                continue;
+            if (primes[i] >= (1uLL << 63) / factors) {
+                words.push_back(factors);
+                factors = 1;
+            }
+            factors *= primes[i];
+        }
+        words.push_back(factors);
+        product = product * product * BigInt::productOf(words);
+    }
+
+    return product;
+}
+
+namespace {
+    constexpr std::array<std::uint64_t, FactorialTable::nativeLimit + 1> nativeFactorials()
+    {
+        std::array<std::uint64_t, FactorialTable::nativeLimit + 1> values {1};
+        for (std::size_t i {1}; i < values.size(); ++i) {
+            values[i] = values[i-1] * i;
+        }
+        return values;
+    }
+}
+
+/*
+ * The table is only locked exclusively when it needs to grow, after which it is checked
+ * again, as another thread may have grown it in between.
+ */
+const BigInt& FactorialTable::operator[](unsigned long n)
+{
+    {
+        std::shared_lock lock {m_mutex};
+        if (n < m_values.size())
+            return m_values[n];
+    }
+
+    std::unique_lock lock {m_mutex};
+    // stored values must not be bound to an arena that the caller has made current
+    ArenaScope heap {nullptr};
+    while (m_values.size() <= n) {
+        m_values.push_back(m_values.back() * static_cast<unsigned long long>(m_values.size()));
+    }
+
+    return m_values[n];
+}
+
+std::uint64_t FactorialTable::native(unsigned long n)
+{
+    static constexpr auto values = nativeFactorials();
+    if (n > nativeLimit)
+        throw std::out_of_range("Factorial exceeds 64 bits");
+
+    return values[n];
 }
 
 TEST_SUITE("test factorial()") {
@@ -37,4 +164,106 @@ TEST_SUITE("test factorial()") {
 
         CHECK_EQ(expected, factorial(n));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("with prime factorisation") {
+        BigInt expected {BigInt::one()};
+        for (unsigned long long i {2}; i <= 3000; ++i) {
+            expected *= i;
+        }
+
+        CHECK_EQ(expected, factorial(3000));
+        CHECK_EQ(expected * BigInt {5uLL}, factorial(3000, BigInt {5uLL}));
+        CHECK_EQ(35'660, factorial(10'000).length());
+        CHECK_EQ(456'574, factorial(100'000).length());
+    }
+
+    TEST_CASE("either side of the prime limit") {
+        BigInt expected {BigInt::one()};
+        for (unsigned long long i {2}; i <= 600; ++i) {
+            expected *= i;
+            if (i >= 400) {
+                CAPTURE(i);
+                CHECK_EQ(expected, factorial(i));
+            }
+        }
+    }
+
+    TEST_CASE("without unnecessary heap allocations") {
+        BigInt expected {BigInt::one()};
+        for (unsigned long long i {2}; i <= 499; ++i) {
+            expected *= BigInt {i};
+        }
+        BigInt actual;
+
+        // below the prime limit, the capacity of the running product grows geometrically,
+        // so its limbs are only reallocated a logarithmic amount of times, instead of once
+        // per factor
+        const auto allocations = countAllocations([&actual] { actual = factorial(499); });
+        CHECK_EQ(expected, actual);
+        CHECK_LE(allocations, 16);
+    }
+}
+
+TEST_SUITE("test FactorialTable") {
+    TEST_CASE("values match factorial()") {
+        FactorialTable table;
+        const auto& f300 = table[300];
+        CHECK_EQ(301, table.size());
+        CHECK_EQ(factorial(300), f300);
+        for (unsigned long n {0}; n <= 600; n += 50) {
+            CHECK_EQ(factorial(n), table[n]);
+        }
+        // growing the table does not move the values already returned
+        CHECK_EQ(&f300, &table[300]);
+        CHECK_EQ(factorial(300), f300);
+    }
+
+    TEST_CASE("native values") {
+        for (unsigned long n {0}; n <= FactorialTable::nativeLimit; ++n) {
+            CHECK_EQ(factorial(n).toULLong(), FactorialTable::native(n));
+        }
+        CHECK_EQ(2'432'902'008'176'640'000uLL, FactorialTable::native(20));
+        CHECK_THROWS_AS(FactorialTable::native(21), std::out_of_range);
+    }
+
+    TEST_CASE("shared between threads") {
+        FactorialTable table;
+        std::vector<std::thread> threads;
+        std::vector<BigInt> results(8);
+        for (unsigned long i {0}; i < results.size(); ++i) {
+            threads.emplace_back([&table, &results, i] {
+                for (unsigned long n {0}; n <= 400; n += i + 1) {
+                    results[i] += table[n];
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (unsigned long i {0}; i < results.size(); ++i) {
+            BigInt expected;
+            for (unsigned long n {0}; n <= 400; n += i + 1) {
+                expected += factorial(n);
+            }
+            CHECK_EQ(expected, results[i]);
+        }
+        CHECK_EQ(401, table.size());
+    }
+
+    TEST_CASE("values outlive arena scopes") {
+        FactorialTable table;
+        Arena arena;
+        {
+            ArenaScope scope {&arena};
+            table[100];
+        }
+        // overwrites all the memory that the scope above rewound
+        const auto capacity = arena.capacity();
+        for (std::size_t bytes {0}; bytes < capacity; bytes += 64) {
+            std::memset(arena.allocate(64, 4), 0xFF, 64);
+        }
+        CHECK_EQ(factorial(100), table[100]);
+        CHECK_EQ(factorial(99), table[99]);
+    }
+}
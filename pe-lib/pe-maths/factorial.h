@@ -1,8 +1,69 @@
 #ifndef PROJECT_EULER_CPP_FACTORIAL_H
 #define PROJECT_EULER_CPP_FACTORIAL_H
 
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <vector>
+
 #include "../pe-custom/big-int.h"
 
 BigInt factorial(unsigned long n, const BigInt& run = BigInt::one());
 
-#endif //PROJECT_EULER_CPP_FACTORIAL_H
\ No newline at end of file
+/*
+ * @return product of every primes[i]^exponents[i], or 1 if primes is empty.
+ */
+BigInt primePowerProduct(const std::vector<unsigned long>& primes,
+                         const std::vector<unsigned long>& exponents);
+
+/*
+ * Memoised factorials, each computed once from the previous one when first requested &
+ * then kept for the lifetime of the table, so repeated queries only cost a lookup.
+ *
+ * The table is safe to share between threads. Lookups of stored values only take a
+ * shared lock, while growing the table takes an exclusive one. Stored values never move,
+ * so returned references stay valid for as long as the table.
+ *
+ * Every factorial up to the largest requested is stored, which takes O(n^2 log n) digits,
+ * so a single very large factorial is better computed directly by factorial().
+ */
+class FactorialTable {
+public:
+    // largest n for which n! fits in 64 bits
+    static constexpr unsigned long nativeLimit {20};
+
+    FactorialTable() : m_values {BigInt::one()} {}
+    FactorialTable(const FactorialTable&) = delete;
+    FactorialTable& operator=(const FactorialTable&) = delete;
+
+    // table shared by the whole process
+    static FactorialTable& shared()
+    {
+        static FactorialTable table;
+        return table;
+    }
+
+    /*
+     * @return n!, with the table first grown up to n if needed.
+     */
+    const BigInt& operator[](unsigned long n);
+    /*
+     * @return n! as a native word, without touching the table.
+     * @throws std::out_of_range if n > nativeLimit.
+     */
+    static std::uint64_t native(unsigned long n);
+
+    // amount of factorials stored, from 0! upwards
+    std::size_t size() const
+    {
+        std::shared_lock lock {m_mutex};
+        return m_values.size();
+    }
+
+private:
+    mutable std::shared_mutex m_mutex;
+    // a deque, as growing it does not move the values already referenced
+    std::deque<BigInt> m_values;
+};
+
+#endif //PROJECT_EULER_CPP_FACTORIAL_H
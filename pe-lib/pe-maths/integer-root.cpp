@@ -0,0 +1,158 @@
+#include "integer-root.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "../../doctest/doctest.h"
+
+namespace {
+    /*
+     * @return true if r^k > n, without overflowing.
+     */
+    bool exceedsPower(unsigned long long r, unsigned k, unsigned long long n)
+    {
+        unsigned long long power {1};
+        for (unsigned i {0}; i < k; ++i) {
+            if (power > n / r)
+                return true;
+            power *= r;
+        }
+
+        return false;
+    }
+}
+
+/*
+ * A double only has 53 bits of precision, so the floating-point square root of values
+ * above 2^53 can be off by 1 either way. The estimate is corrected using divisions
+ * rather than squares, so that no intermediate value can overflow.
+ *
+ * @return floor of the square root of n.
+ */
+unsigned long long isqrt(unsigned long long n)
+{
+    auto r = static_cast<unsigned long long>(std::sqrt(static_cast<double>(n)));
+    while (r && r > n / r) {
+        --r;
+    }
+    while (r + 1 <= n / (r + 1)) {
+        ++r;
+    }
+
+    return r;
+}
+
+/*
+ * @return floor of the kth root of n.
+ * @throws std::invalid_argument if k = 0.
+ */
+unsigned long long iroot(unsigned long long n, unsigned k)
+{
+    if (!k)
+        throw std::invalid_argument("Root degree must be positive");
+    if (k == 1 || n < 2)
+        return n;
+    if (k == 2)
+        return isqrt(n);
+    // 2^64 > n for all larger k
+    if (k >= 64)
+        return 1;
+
+    auto r = static_cast<unsigned long long>(
+            std::pow(static_cast<double>(n), 1.0 / static_cast<double>(k)));
+    while (r > 1 && exceedsPower(r, k, n)) {
+        --r;
+    }
+    while (!exceedsPower(r + 1, k, n)) {
+        ++r;
+    }
+
+    return r;
+}
+
+/*
+ * Exponents are tried from largest to smallest, so the first exact root found has the
+ * smallest possible base. 2^64 > n, so no exponent above 63 can work.
+ *
+ * @return true if n equals m^e for integers m > 1 & e > 1, in which case m & the
+ * largest such e are stored in base & exponent, if provided.
+ */
+bool isPerfectPower(unsigned long long n, unsigned long long* base, unsigned* exponent)
+{
+    if (n < 4)
+        return false;
+
+    for (unsigned k {63}; k >= 2; --k) {
+        const auto r = iroot(n, k);
+        // r^k <= n always, so it is exact if it also exceeds n - 1
+        if (r >= 2 && exceedsPower(r, k, n - 1)) {
+            if (base != nullptr)
+                *base = r;
+            if (exponent != nullptr)
+                *exponent = k;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+TEST_SUITE("test integer roots") {
+    TEST_CASE("isqrt() with small values") {
+        unsigned long long nValues[] {0, 1, 2, 3, 4, 8, 9, 10, 99, 100, 101};
+        unsigned long long expected[] {0, 1, 1, 1, 2, 2, 3, 3, 9, 10, 10};
+
+        for (const auto& n : nValues) {
+            auto i = &n - &nValues[0];
+            CHECK_EQ(expected[i], isqrt(n));
+        }
+    }
+
+    TEST_CASE("isqrt() around squares beyond double precision") {
+        const unsigned long long roots[] {94'906'265, 3'037'000'499, 4'294'967'295};
+
+        for (const auto& r : roots) {
+            CHECK_EQ(r, isqrt(r * r));
+            CHECK_EQ(r - 1, isqrt(r * r - 1));
+            CHECK_EQ(r, isqrt(r * r + 1));
+        }
+        CHECK_EQ(4'294'967'295, isqrt(UINT64_MAX));
+    }
+
+    TEST_CASE("iroot()") {
+        CHECK_THROWS_AS(iroot(8, 0), std::invalid_argument);
+        CHECK_EQ(8, iroot(8, 1));
+        CHECK_EQ(2, iroot(8, 3));
+        CHECK_EQ(1, iroot(7, 3));
+        CHECK_EQ(1, iroot(UINT64_MAX, 64));
+        CHECK_EQ(2, iroot(UINT64_MAX, 63));
+        CHECK_EQ(2'642'245, iroot(UINT64_MAX, 3));
+        CHECK_EQ(1'000'000, iroot(1'000'000'000'000'000'000, 3));
+        CHECK_EQ(999'999, iroot(999'999'999'999'999'999, 3));
+        CHECK_EQ(10, iroot(10'000'000'000'000'000'000uLL, 19));
+        CHECK_EQ(9, iroot(10'000'000'000'000'000'000uLL - 1, 19));
+    }
+
+    TEST_CASE("isPerfectPower()") {
+        unsigned long long base {};
+        unsigned exponent {};
+
+        CHECK(isPerfectPower(4, &base, &exponent));
+        CHECK_EQ(2, base);
+        CHECK_EQ(2, exponent);
+        CHECK(isPerfectPower(1uLL << 63, &base, &exponent));
+        CHECK_EQ(2, base);
+        CHECK_EQ(63, exponent);
+        CHECK(isPerfectPower(1'000'000, &base, &exponent));
+        CHECK_EQ(10, base);
+        CHECK_EQ(6, exponent);
+        CHECK(isPerfectPower(4'294'967'295uLL * 4'294'967'295uLL, &base, &exponent));
+        CHECK_EQ(4'294'967'295, base);
+        CHECK_EQ(2, exponent);
+
+        unsigned long long nValues[] {0, 1, 2, 3, 5, 12, 72, 999'999, UINT64_MAX};
+        for (const auto& n : nValues) {
+            CHECK_FALSE(isPerfectPower(n));
+        }
+    }
+}
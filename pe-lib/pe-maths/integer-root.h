@@ -0,0 +1,9 @@
+#ifndef PROJECT_EULER_CPP_INTEGER_ROOT_H
+#define PROJECT_EULER_CPP_INTEGER_ROOT_H
+
+unsigned long long isqrt(unsigned long long n);
+unsigned long long iroot(unsigned long long n, unsigned k);
+bool isPerfectPower(unsigned long long n, unsigned long long* base = nullptr,
+                    unsigned* exponent = nullptr);
+
+#endif //PROJECT_EULER_CPP_INTEGER_ROOT_H
@@ -0,0 +1,60 @@
+#include "count-allocations.h"
+
+#include <cstdlib>
+#include <new>
+
+/*
+ * Replacement allocation functions, which only test executables link, so that library
+ * builds keep the default ones. Every form is replaced, so that each deallocation
+ * function matches the allocation function that produced the memory.
+ */
+std::atomic<std::size_t> allocationCount {};
+
+namespace {
+    void* allocate(std::size_t size)
+    {
+        ++allocationCount;
+        if (auto* ptr = std::malloc(size ? size : 1))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        ++allocationCount;
+        const auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc() requires a size that is a multiple of the alignment
+        const auto rounded = ((size ? size : 1) + align - 1) / align * align;
+        if (auto* ptr = std::aligned_alloc(align, rounded))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,25 @@
+#ifndef PROJECT_EULER_CPP_COUNT_ALLOCATIONS_H
+#define PROJECT_EULER_CPP_COUNT_ALLOCATIONS_H
+
+#include <atomic>
+#include <cstddef>
+
+/*
+ * Running total of heap allocations made through the global operator new, which is
+ * replaced in count-allocations.cpp, which only test executables link.
+ */
+extern std::atomic<std::size_t> allocationCount;
+
+/*
+ * @return amount of heap allocations made while invoking action.
+ */
+template <typename F>
+std::size_t countAllocations(F action)
+{
+    const std::size_t before = allocationCount;
+    action();
+
+    return allocationCount - before;
+}
+
+#endif //PROJECT_EULER_CPP_COUNT_ALLOCATIONS_H
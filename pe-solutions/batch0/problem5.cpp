@@ -17,6 +17,7 @@
 
 #include "../../doctest/doctest.h"
 
+#include "pe-custom/big-int.h"
 #include "pe-maths/primes.h"
 
 /*
@@ -40,6 +41,21 @@ unsigned long long lcmOfRange(unsigned short n)
             });
 }
 
+/*
+ * Same as the above, but accumulates a BigInt, so that the result does not overflow
+ * for N > 40. Each term fits in a machine word, so every gcd() is a single word modulo
+ * of the accumulator followed by a native gcd.
+ */
+BigInt lcmOfLargeRange(unsigned short n)
+{
+    BigInt result {1uLL};
+    for (unsigned long long num = n / 2 + 1; num <= n; ++num) {
+        result = lcm(result, BigInt {num});
+    }
+
+    return result;
+}
+
 /*
  * Uses prime numbers to calculate the lcm of a range, based on the formula:
  *
@@ -82,6 +98,7 @@ TEST_CASE("test lower constraints") {
         auto i = &n - &nValues[0];
         CHECK_EQ(expected[i], lcmOfRange(n));
         CHECK_EQ(expected[i], lcmOfRangeUsingPrimes(n));
+        CHECK_EQ(BigInt {expected[i]}, lcmOfLargeRange(n));
     }
 }
 
@@ -93,6 +110,7 @@ TEST_CASE("test mid constraints") {
         auto i = &n - &nValues[0];
         CHECK_EQ(expected[i], lcmOfRange(n));
         CHECK_EQ(expected[i], lcmOfRangeUsingPrimes(n));
+        CHECK_EQ(BigInt {expected[i]}, lcmOfLargeRange(n));
     }
 }
 
@@ -104,5 +122,21 @@ TEST_CASE("test upper constraints") {
         auto i = &n - &nValues[0];
         CHECK_EQ(expected[i], lcmOfRange(n));
         CHECK_EQ(expected[i], lcmOfRangeUsingPrimes(n));
+        CHECK_EQ(BigInt {expected[i]}, lcmOfLargeRange(n));
+    }
+}
+
+TEST_CASE("test beyond native limits") {
+    CHECK_EQ(BigInt {"69720375229712477164533808935312303556800"}, lcmOfLargeRange(100));
+
+    const unsigned short n {5000};
+    std::vector<BigInt> primePowers;
+    for (const auto& prime : primeNumbers(n)) {
+        unsigned long long power {prime};
+        while (power * prime <= n) {
+            power *= prime;
+        }
+        primePowers.emplace_back(power);
     }
+    CHECK_EQ(BigInt::productOf(primePowers), lcmOfLargeRange(n));
 }
\ No newline at end of file
@@ -16,12 +16,12 @@
  *       product = 3*4*5 = 60
  */
 
-#include <cmath>
 #include <functional>
 #include <optional>
 
 #include "../../doctest/doctest.h"
 
+#include "pe-maths/integer-root.h"
 #include "pe-maths/pythagorean.h"
 
 inline int product(const triple& triplet)
@@ -64,7 +64,7 @@ std::optional<triple> maxTripletBruteBC(unsigned short n)
             auto a = diff - b;
             if (b <= a)
                 break;
-            if (std::hypot(a, b) == c) {
+            if (a * a + b * b == c * c) {
                 maxTriplet = {a, b, c};
                 break;
             }
@@ -100,7 +100,7 @@ std::optional<triple> maxTripletBruteA(unsigned short n)
     for (int a = n / 3 - 1; a >= 3; --a) {
         auto b = n * (n - 2 * a) / (2 * (n - a));
         auto c = n - a - b;
-        if (a < b && std::hypot(a, b) == c) {
+        if (a < b && a * a + b * b == c * c) {
             maxTriplet = {a, b, c};
             break;
         }
@@ -129,9 +129,11 @@ std::optional<triple> maxTripletOptimised(unsigned short num)
 
     std::optional<triple> maxTriplet;
 
-    const auto limit = num / 2;
-    const auto mMax = std::ceil(std::sqrt(limit));
-    for (int m {2}; m < mMax; ++m) {
+    const unsigned long limit = num / 2;
+    // ceiling of sqrt(limit), without rounding errors
+    const auto root = isqrt(limit);
+    const auto mMax = root + (root * root < limit);
+    for (unsigned long m {2}; m < mMax; ++m) {
         if (!(limit % m)) {
             // find even divisor m (> 1) of num/2
             auto kMax = limit / m;
@@ -156,7 +158,7 @@ std::optional<triple> maxTripletOptimised(unsigned short num)
 }
 
 TEST_CASE("test no value returned if no triplet found") {
-    unsigned short nValues[] {4, 6, 31, 99, 100};
+    unsigned short nValues[] {0, 2, 4, 6, 31, 99, 100};
 
     for (const auto& n : nValues) {
         CHECK_FALSE(maxTripletBruteBC(n).has_value());
@@ -14,11 +14,9 @@
  *       1st 2 digits = 21
  */
 
-#include <numeric>
-
 #include "../../doctest/doctest.h"
 
-#include "pe-custom/big-int.h"
+#include "pe-custom/big-int-accumulator.h"
 #include "pe-custom/rolling-queue.h"
 #include "pe-tests/get-test-resource.h"
 
@@ -58,17 +56,18 @@ std::string addInReverse(const std::vector<std::string>& numbers)
     return output.toString();
 }
 
+/*
+ * Solution uses custom BigIntAccumulator class, which adds every number directly from
+ * its string, deferring all carries until the leading digits are read.
+ */
 std::string sliceSum(const std::vector<std::string>& numbers)
 {
-    return std::accumulate(
-            numbers.cbegin(),
-            numbers.cend(),
-            BigInt::zero(),
-            [](BigInt& acc, std::string num) {
-                return acc + BigInt {num};
-            })
-            .toString()
-            .substr(0, 10);
+    BigIntAccumulator sum;
+    for (const auto& number: numbers) {
+        sum += number;
+    }
+
+    return sum.leadingDigits(10);
 }
 
 TEST_CASE("test when N = 1") {
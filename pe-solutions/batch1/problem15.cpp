@@ -17,6 +17,7 @@
 #include "../../doctest/doctest.h"
 
 #include "pe-combinatorics/binomial-coeff.h"
+#include "pe-combinatorics/mod-combinatorics.h"
 
 /*
  * Calculates distinct permutations with identical items.
@@ -39,14 +40,29 @@
  * since grid dimensions determine the number of steps taken & there is a deterministic
  * proportion of R vs D steps.
  *
+ * binomialCoefficient() assembles C(1000, 500) from its prime factors, without computing
+ * any of the factorials above.
+ *
  * @return number of valid routes scaled down to modulo (1e9 + 7).
  */
 BigInt latticePathRoutes(unsigned short n, unsigned short m)
 {
-    BigInt mod {1'000'000'007uLL};
+    const unsigned long long mod {1'000'000'007uLL};
     BigInt routes = binomialCoefficient(n + m, m);
 
-    return routes % mod;
+    return BigInt {routes % mod};
+}
+
+/*
+ * Solution uses the same formula as above, but only ever modulo (1e9 + 7), with
+ * factorials & inverse factorials up to the largest possible n + m looked up in tables
+ * that are built once, so that every query takes constant time.
+ */
+unsigned long latticePathRoutesModular(unsigned short n, unsigned short m)
+{
+    static const ModCombinatorics<1'000'000'007> combinatorics {1000};
+
+    return combinatorics.binomial(n + m, m);
 }
 
 /*
@@ -119,6 +135,7 @@ TEST_SUITE("test latticePath()") {
         for (unsigned short n {1}; n < 4; ++n) {
             const BigInt expectedBI {expected[n-1]};
             CHECK_EQ(expectedBI.toString(), latticePathRoutes(n, n).toString());
+            CHECK_EQ(expected[n-1], latticePathRoutesModular(n, n));
             CHECK_EQ(expected[n-1], lattice[n][n]);
         }
     }
@@ -131,18 +148,20 @@ TEST_SUITE("test latticePath()") {
             auto i = &n - &nValues[0];
             const BigInt expectedBI {expected[i]};
             CHECK_EQ(expectedBI.toString(), latticePathRoutes(n, n).toString());
+            CHECK_EQ(expected[i], latticePathRoutesModular(n, n));
             CHECK_EQ(expected[i], lattice[n][n]);
         }
     }
 
     TEST_CASE("test upper constraints") {
-        unsigned short nValues[] {200, 400};
-        unsigned long long expected[] {587'893'473, 358'473'912};
+        unsigned short nValues[] {200, 400, 500};
+        unsigned long long expected[] {587'893'473, 358'473'912, 159'835'829};
 
         for (const auto& n : nValues) {
             auto i = &n - &nValues[0];
             const BigInt expectedBI {expected[i]};
             CHECK_EQ(expectedBI.toString(), latticePathRoutes(n, n).toString());
+            CHECK_EQ(expected[i], latticePathRoutesModular(n, n));
             CHECK_EQ(expected[i], lattice[n][n]);
         }
     }
@@ -156,6 +175,7 @@ TEST_SUITE("test latticePath()") {
             auto i = &n - &nValues[0];
             const BigInt expectedBI {expected[i]};
             CHECK_EQ(expectedBI.toString(), latticePathRoutes(n, mValues[i]).toString());
+            CHECK_EQ(expected[i], latticePathRoutesModular(n, mValues[i]));
             CHECK_EQ(expected[i], lattice[n][mValues[i]]);
         }
     }
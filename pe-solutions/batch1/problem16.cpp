@@ -15,20 +15,20 @@
 #include "../../doctest/doctest.h"
 
 #include "pe-custom/big-int.h"
-#include "pe-strings/utility.h"
 
 /*
  * This solution does not handle N > 1e3 well.
  */
 unsigned long expDigSumIterative(unsigned long n)
 {
-    BigInt power = BigInt {2uLL}.pow(BigInt {n});
-    const BigInt ten = BigInt::ten(), zero = BigInt::zero();
+    BigInt power = BigInt {2uLL}.pow(n);
+    const BigInt zero = BigInt::zero();
     unsigned long total {};
 
     while (power != zero) {
-        total += (power % ten).toULong();
-        power /= ten;
+        auto [quotient, digit] = divmod(power, 10uLL);
+        total += digit;
+        power = quotient;
     }
 
     return total;
@@ -36,9 +36,7 @@ unsigned long expDigSumIterative(unsigned long n)
 
 unsigned long expDigSum(unsigned long n)
 {
-    const auto number = BigInt {2uLL}.pow(BigInt {n}).toString();
-
-    return characterSum(number);
+    return BigInt {2uLL}.pow(n).digitSum();
 }
 
 TEST_CASE("test lower constraints") {
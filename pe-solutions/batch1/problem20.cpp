@@ -15,13 +15,10 @@
 #include "../../doctest/doctest.h"
 
 #include "pe-maths/factorial.h"
-#include "pe-strings/utility.h"
 
 unsigned long factorialDigitSum(unsigned short n)
 {
-    auto result = factorial(n).toString();
-
-    return characterSum(result);
+    return factorial(n).digitSum();
 }
 
 TEST_CASE("test lower constraints") {
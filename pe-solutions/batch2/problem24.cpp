@@ -30,8 +30,11 @@
  * 1 is used with the new string "abd". This continues until n = 0 and "cabd" is returned
  * by the base case.
  *
+ * Batch sizes are looked up in FactorialTable, as every possible input length has a
+ * factorial that fits in a native word.
+ *
  * N.B. The creation of a storage string to pass into every recursive call is
- * unnecessary. Also, the amount of factorial calls can be reduced since x! / x = (x - 1)!
+ * unnecessary.
  *
  * @param [n] the nth permutation requested should be zero-indexed.
  * @param [input] the object to generate permutations of should be already sorted in
@@ -42,7 +45,7 @@ std::string lexicographicPerm(unsigned long long n, std::string input)
     if (input.length() == 1)
         return input;
 
-    auto batchSize = factorial(input.length() - 1).toULLong();
+    auto batchSize = FactorialTable::native(input.length() - 1);
     auto i = n / batchSize;
     char starter = input[i];
     input.erase(i, 1);
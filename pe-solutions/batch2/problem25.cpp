@@ -13,6 +13,7 @@
  */
 
 #include <cmath>
+#include <utility>
 
 #include "../../doctest/doctest.h"
 
@@ -37,10 +38,9 @@ unsigned long* nDigitFibTermsBrute(unsigned short maxDigits)
     terms[0] = 7;
 
     for (unsigned long term {8}, digits {3}; digits <= maxDigits; ++term) {
-        // should std::swap() or std::move() be used here?
-        auto fNMinus2 {fNMinus1};
-        fNMinus1 = fN;
-        fN = fNMinus1 + fNMinus2;
+        // the older term is overwritten in place by the sum, so no BigInt is copied
+        fNMinus1 += fN;
+        std::swap(fNMinus1, fN);
         if (fN.length() == digits) {
             terms[digits-2] = term;
             digits++;
@@ -25,7 +25,9 @@
 
 #include "../../doctest/doctest.h"
 
-#include "pe-custom/big-int.h"
+#include "pe-custom/decimal-expansion.h"
+#include "pe-custom/montgomery.h"
+#include "pe-maths/prime-factors.h"
 #include "pe-maths/primes.h"
 
 /*
@@ -63,12 +65,11 @@ unsigned long longestRepetendDenomUsingPrimes(unsigned long n)
     const std::vector<unsigned long> primes(allPrimes.cbegin() + 3, allPrimes.cend());
 
     unsigned long denominator {3}, longestK {1};
-    BigInt one {BigInt::one()}, ten {BigInt::ten()};
 
     for (auto& p : primes) {
-        BigInt pBI {1uLL * p};
+        const MontgomeryContext<std::uint64_t> context {p};
         for (int k {1}; k < p; ++k) {
-            if (ten.modPow(BigInt {1uLL * k}, pBI) == one) {
+            if (context.powmod(10, k) == 1) {
                 if (k > longestK) {
                     longestK = k;
                     denominator = p;
@@ -105,12 +106,11 @@ unsigned long longestRepetendDenomUsingPrimesImproved(unsigned long n)
     const std::vector<unsigned long> primes(allPrimes.rbegin(), allPrimes.rend());
 
     unsigned long denominator {3};
-    BigInt one {BigInt::one()}, ten {BigInt::ten()};
 
     for (auto& p : primes) {
         unsigned long k {1};
-        BigInt pBI {1uLL * p};
-        while (ten.modPow(BigInt {1uLL * k}, pBI) != one) {
+        const MontgomeryContext<std::uint64_t> context {p};
+        while (context.powmod(10, k) != 1) {
             k++;
         }
         if (k == p - 1) {
@@ -123,29 +123,24 @@ unsigned long longestRepetendDenomUsingPrimesImproved(unsigned long n)
 }
 
 /*
- * Repeatedly divides & stores decimal parts until a decimal part is repeated &
- * compares length of stored parts.
+ * Finds the length of the repetend of 1/d by Brent's cycle detection on the remainders
+ * of the long division, which needs no storage of the remainders already seen.
+ *
+ * Only odd denominators in the upper half are considered, as any smaller or even
+ * denominator has a multiple in that range with at least the same repetend length.
  */
 unsigned long longestRepetendDenominator(unsigned long n)
 {
     const auto upperN = n & 1 ? n - 2 : n - 1;
     const auto lowerN = upperN / 2;
-    unsigned long longestK {};
-    std::vector<unsigned long> remainders;
+    unsigned long long longestK {};
 
     for (unsigned long i {upperN}; i >= lowerN; i -= 2) {
         if (longestK >= i)
             break;
-        // better to just initialise a fresh local vector every iteration?
-        remainders.resize(i);
-        std::fill(remainders.begin(), remainders.end(), 0uLL);
-        unsigned long remainder {1}, pos {};
-        while (!remainders[remainder] && remainder) {
-            remainders[remainder] = pos++;
-            remainder = remainder * 10 % i;
-        }
-        if (pos - remainders[remainder] >= longestK) {
-            longestK = pos - remainders[remainder];
+        const auto k = DecimalExpansion<unsigned long long> {1, i}.cycle().period;
+        if (k >= longestK) {
+            longestK = k;
             n = i;
         }
     }
@@ -153,6 +148,27 @@ unsigned long longestRepetendDenominator(unsigned long n)
     return n;
 }
 
+/*
+ * Finds the length of the repetend of 1/d directly, as the multiplicative order of 10
+ * modulo the part of d co-prime to 10, using the prime factorisation of d.
+ */
+unsigned long longestRepetendDenomUsingOrder(unsigned long n)
+{
+    unsigned long denominator {3};
+    unsigned long long longestK {1};
+
+    for (unsigned long i {n - 1}; i > longestK; --i) {
+        const DecimalExpansion<unsigned long long> expansion {1, i};
+        const auto k = expansion.cycle(primeFactors(i)).period;
+        if (k > longestK || (k == longestK && i < denominator)) {
+            longestK = k;
+            denominator = i;
+        }
+    }
+
+    return denominator;
+}
+
 TEST_CASE("test lower constraints") {
     unsigned long nValues[] {5, 10, 14, 19, 25};
     unsigned long expected[] {3, 7, 7, 17, 23};
@@ -162,6 +178,7 @@ TEST_CASE("test lower constraints") {
         CHECK_EQ(expected[i], longestRepetendDenomUsingPrimes(n));
         CHECK_EQ(expected[i], longestRepetendDenomUsingPrimesImproved(n));
         CHECK_EQ(expected[i], longestRepetendDenominator(n));
+        CHECK_EQ(expected[i], longestRepetendDenomUsingOrder(n));
     }
 }
 
@@ -174,6 +191,7 @@ TEST_CASE("test mid constraints") {
         CHECK_EQ(expected[i], longestRepetendDenomUsingPrimes(n));
         CHECK_EQ(expected[i], longestRepetendDenomUsingPrimesImproved(n));
         CHECK_EQ(expected[i], longestRepetendDenominator(n));
+        CHECK_EQ(expected[i], longestRepetendDenomUsingOrder(n));
     }
 }
 
@@ -186,5 +204,6 @@ TEST_CASE("test upper constraints") {
         CHECK_EQ(expected[i], longestRepetendDenomUsingPrimes(n));
         CHECK_EQ(expected[i], longestRepetendDenomUsingPrimesImproved(n));
         CHECK_EQ(expected[i], longestRepetendDenominator(n));
+        CHECK_EQ(expected[i], longestRepetendDenomUsingOrder(n));
     }
 }
\ No newline at end of file
@@ -26,10 +26,13 @@
 #include "../../doctest/doctest.h"
 
 #include "pe-custom/big-int.h"
+#include "pe-custom/uint.h"
 
 namespace spiral {
-    const BigInt modulus {1'000'000'007uLL};
-    const BigInt one {BigInt::one()}, two {"2"}, three {"3"};
+    const unsigned long long modulus {1'000'000'007uLL};
+    // 3^-1 modulo 1e9 + 7, as 3 * 333'333'336 = 1e9 + 8
+    const unsigned long long inverseOf3 {333'333'336uLL};
+    const BigInt one {BigInt::one()};
 }
 
 /*
@@ -37,17 +40,17 @@ namespace spiral {
  */
 unsigned long spiralDiagSumBrute(unsigned long long n)
 {
-    BigInt nBI {n}, sum {spiral::one}, num {spiral::one}, step {spiral::two};
+    BigInt nBI {n}, sum {spiral::one}, num {spiral::one}, step {2uLL};
 
     while (step < nBI) {
         for (int i {0}; i < 4; ++i) {
             num += step;
             sum += num;
         }
-        step += spiral::two;
+        step += 2uLL;
     }
 
-    return (sum % spiral::modulus).toULong();
+    return sum % spiral::modulus;
 }
 
 /*
@@ -72,13 +75,12 @@ unsigned long spiralDiagSumFormulaBrute(unsigned long long n)
     BigInt maxNum {static_cast<unsigned long long>(std::ceil(n / 2.0))};
 
     while (num < maxNum) {
-        auto even = spiral::two * num;
-        auto odd = even + spiral::one;
-        fN += BigInt {"4"} * odd * odd - BigInt {"6"} * even;
+        auto odd = num * 2uLL + 1uLL;
+        fN += odd * odd * 4uLL - num * 12uLL;
         num++;
     }
 
-    return (fN % spiral::modulus).toULong();
+    return fN % spiral::modulus;
 }
 /*
  * Solution optimised based on the same formula as above, but reduced to:
@@ -98,13 +100,28 @@ unsigned long spiralDiagSumFormulaBrute(unsigned long long n)
  */
 unsigned long spiralDiagSumFormulaDerived(unsigned long long n)
 {
-    BigInt x {(n - 1) / 2};
-    auto sum = BigInt {"16"} * x.pow(spiral::three);
-    sum += BigInt {"30"} * x * x;
-    sum += BigInt {"26"} * x + spiral::three;
-    sum /= spiral::three;
+    // x < 2^59 for the upper constraint, so the result stays below 2^181 and a
+    // fixed-width integer avoids any heap allocation
+    UInt<256> x {(n - 1) / 2};
+    auto sum = ((x * 16 + 30) * x + 26) * x + 3;
+    sum /= 3;
 
-    return (sum % spiral::modulus).toULong();
+    return (sum % spiral::modulus).toULLong();
+}
+
+/*
+ * Solution evaluates the same closed-form formula modulo (1e9 + 7) throughout, with the
+ * division by 3 replaced by a multiplication by its modular inverse, so every
+ * intermediate value fits in a native word.
+ *
+ * @return integer value of result % (1e9 + 7)
+ */
+unsigned long spiralDiagSumModular(unsigned long long n)
+{
+    const std::uint64_t x {(n - 1) / 2 % spiral::modulus};
+    const auto sum = ((x * 16 + 30) % spiral::modulus * x + 26) % spiral::modulus * x + 3;
+
+    return sum % spiral::modulus * spiral::inverseOf3 % spiral::modulus;
 }
 
 TEST_CASE("test lower constraints") {
@@ -116,6 +133,7 @@ TEST_CASE("test lower constraints") {
         CHECK_EQ(expected[i], spiralDiagSumBrute(n));
         CHECK_EQ(expected[i], spiralDiagSumFormulaBrute(n));
         CHECK_EQ(expected[i], spiralDiagSumFormulaDerived(n));
+        CHECK_EQ(expected[i], spiralDiagSumModular(n));
     }
 }
 
@@ -128,6 +146,7 @@ TEST_CASE("test mid constraints") {
         CHECK_EQ(expected[i], spiralDiagSumBrute(n));
         CHECK_EQ(expected[i], spiralDiagSumFormulaBrute(n));
         CHECK_EQ(expected[i], spiralDiagSumFormulaDerived(n));
+        CHECK_EQ(expected[i], spiralDiagSumModular(n));
     }
 }
 
@@ -138,4 +157,12 @@ TEST_CASE("test upper constraints") {
     CHECK_EQ(expected, spiralDiagSumBrute(n));
     CHECK_EQ(expected, spiralDiagSumFormulaBrute(n));
     CHECK_EQ(expected, spiralDiagSumFormulaDerived(n));
-}
\ No newline at end of file
+    CHECK_EQ(expected, spiralDiagSumModular(n));
+}
+
+TEST_CASE("test modular formula near the upper constraint") {
+    const unsigned long long start {999'999'999'999'999'001};
+    for (unsigned long long n {start}; n < start + 2000; n += 2) {
+        CHECK_EQ(spiralDiagSumFormulaDerived(n), spiralDiagSumModular(n));
+    }
+}
@@ -13,7 +13,7 @@
  *       count = 8
  */
 
-#include <set>
+#include <unordered_set>
 
 #include "../../doctest/doctest.h"
 
@@ -21,12 +21,12 @@
 
 unsigned long long distinctPowersBrute(unsigned long n)
 {
-    std::set<BigInt> distinct;
+    std::unordered_set<BigInt> distinct;
+    distinct.reserve((n - 1) * (n - 1));
 
     for (int a {2}; a <= n; ++a) {
         for (int b {2}; b <= n; ++b) {
-            auto power = BigInt {1uLL * a}.pow(BigInt {1uLL * b});
-            distinct.insert(power);
+            distinct.insert(BigInt {1uLL * a}.pow(1uLL * b));
         }
     }
 
@@ -19,6 +19,7 @@
 #include "../../doctest/doctest.h"
 
 #include "pe-custom/big-int.h"
+#include "pe-tests/count-allocations.h"
 
 namespace coinSum {
     const BigInt zero {BigInt::zero()}, one {BigInt::one()};
@@ -29,8 +30,11 @@ namespace coinSum {
 /*
  * Repeatedly subtract each coin value from the target value & sum combos previously
  * calculated for smaller targets.
+ *
+ * Results are returned by reference into the cache, so that summing them does not
+ * copy every memoised BigInt.
  */
-BigInt recursiveCombos(int n, int coin, std::vector<std::vector<BigInt>>& cache)
+const BigInt& recursiveCombos(int n, int coin, std::vector<std::vector<BigInt>>& cache)
 {
     if (coin < 1)
         return coinSum::one;
@@ -43,9 +47,9 @@ BigInt recursiveCombos(int n, int coin, std::vector<std::vector<BigInt>>& cache)
         combos += recursiveCombos(target, coin - 1, cache);
         target -= coinSum::coins[coin];
     }
-    cache[n][coin] = combos;
+    cache[n][coin] = std::move(combos);
 
-    return combos;
+    return cache[n][coin];
 }
 
 /*
@@ -60,15 +64,14 @@ BigInt recursiveCombos(int n, int coin, std::vector<std::vector<BigInt>>& cache)
  */
 unsigned long countCoinCombosRecursive(int n, int coin = 7)
 {
-    const BigInt modulus {coinSum::modulus};
     std::vector<std::vector<BigInt>> recursiveMemo(
             100'001,
             {coinSum::zero, coinSum::zero, coinSum::zero, coinSum::zero, coinSum::zero,
              coinSum::zero, coinSum::zero, coinSum::zero}
             );
 
-    auto ans = recursiveCombos(n, coin, recursiveMemo);
-    return (ans % modulus).toULong();
+    const auto& ans = recursiveCombos(n, coin, recursiveMemo);
+    return ans % coinSum::modulus;
 }
 
 /*
@@ -115,6 +118,26 @@ TEST_CASE("test mid constraints") {
     }
 }
 
+TEST_CASE("test recursive combos without unnecessary heap allocations") {
+    const int n {200};
+    std::vector<std::vector<BigInt>> cache(n + 1, std::vector<BigInt>(8));
+    BigInt actual;
+
+    const auto allocations = countAllocations([&cache, &actual] {
+        actual = recursiveCombos(n, 7, cache);
+    });
+    std::size_t memoised {};
+    for (const auto& row : cache) {
+        memoised += std::count_if(row.cbegin(), row.cend(), [](const BigInt& combos) {
+            return combos > coinSum::zero;
+        });
+    }
+
+    CHECK_EQ(BigInt {73682uLL}, actual);
+    // 1 allocation for each memoised sum, as none of the summed results are copied
+    CHECK_LE(allocations, memoised);
+}
+
 TEST_CASE("test upper constraints") {
     int n {100'000};
     unsigned long expected {836'633'026};
@@ -35,10 +35,9 @@
 unsigned long sumOfDigitFactorialsHR(unsigned long n)
 {
     unsigned long sum {};
-    // better to just declare a const array hard-coded in using?
     unsigned long factorials[10];
     for (int i {0}; i < 10; ++i) {
-        factorials[i] = factorial(i).toULong();
+        factorials[i] = FactorialTable::native(i);
     }
 
     for (unsigned long num {10}; num < n; ++num) {
@@ -69,10 +68,9 @@ unsigned long sumOfDigitFactorialsHR(unsigned long n)
 unsigned long sumOfDigitFactorialsPE()
 {
     unsigned long sum {};
-    // better to just declare a const array hard-coded in using?
     unsigned long factorials[10];
     for (int i {0}; i < 10; ++i) {
-        factorials[i] = factorial(i).toULong();
+        factorials[i] = FactorialTable::native(i);
     }
 
     const int limit {2'000'000};